@@ -0,0 +1,228 @@
+/**
+ * @file ChemgenJacobian.h
+ * @brief Derivatives of chemgen's production rates and cp, shared by the reactor models.
+ * @details
+ *   IdealGasConstPressureAdiabaticReactor and Reactor<N> both need d(omega)/dC,
+ *   d(omega)/dT and d(cp_bar)/dT at the current state; they differ only in where
+ *   the result is stored. d(omega)/dC is exact when the mechanism provides
+ *   source_jacobian(), otherwise a difference quotient, colored on a CSC pattern
+ *   or dense (Reactor<N>, and the pattern check of the CP reactor). chemgen has no
+ *   temperature derivative of the source, so d(omega)/dT is always a one-sided
+ *   difference quotient. d(cp_bar)/dT is exact.
+ *
+ *   Include after the chemgen headers: the functions are found by ordinary
+ *   lookup, and hasSourceJacobian is false if source_jacobian() has not
+ *   been declared by then.
+ */
+
+#ifndef SRC_REACTOR_CHEMGEN_JACOBIAN
+#define SRC_REACTOR_CHEMGEN_JACOBIAN
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace ChemgenJacobian
+{
+    inline constexpr double SQRT_EPS = 1.0e-8;                                  /* ~sqrt(machine epsilon) */
+
+
+    /**
+     * @brief Whether the chemgen mechanism provides source_jacobian(C, T).
+     */
+    template<typename S>
+    inline constexpr bool hasSourceJacobian = requires(const S& C, const double& T) { source_jacobian(C, T)[0][0]; };
+
+
+    /**
+     * @brief d(omega)/dC from chemgen's source_jacobian(), when the mechanism provides it.
+     * @param[in] C Concentrations.
+     * @param[in] T Temperature [K].
+     * @param[in] scale Factor applied to every entry (the rate multiplier).
+     * @param[in] colptrs, rowvals CSC pattern of d(omega)/dC.
+     * @param[out] dwdC Values on the pattern.
+     * @return false if chemgen has no source_jacobian(); @p dwdC is then untouched.
+     * @details source_jacobian(C, T)[i][j] = d(omega_i)/d(C_j) at fixed T, assembled by
+     *          chemgen from the derivatives of each reaction's rate of progress.
+     */
+    template<typename S>
+    bool sourceJacobian(const S& C, double T, double scale, const std::vector<int>& colptrs,
+                        const std::vector<int>& rowvals, std::vector<double>& dwdC)
+    {
+        if constexpr (hasSourceJacobian<S>)
+        {
+            auto J = source_jacobian(C, T);
+            for(int j = 0; j + 1 < static_cast<int>(colptrs.size()); j++)
+            {
+                for(int k = colptrs[j]; k < colptrs[j + 1]; k++)
+                {
+                    dwdC[k] = scale * J[rowvals[k]][j];
+                }
+            }
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+
+    /**
+     * @brief d(omega)/dC by difference quotients, one source_species() call per color.
+     * @param[in] C Concentrations.
+     * @param[in] T Temperature [K] (held fixed).
+     * @param[in] omega Production rates at (C, T), already scaled by @p scale.
+     * @param[in] scale Rate multiplier.
+     * @param[in] colptrs, rowvals CSC pattern of d(omega)/dC.
+     * @param[in] color_ptrs, color_cols Columns of color c: color_cols[color_ptrs[c] .. color_ptrs[c+1]).
+     * @param[out] dwdC Values on the pattern.
+     * @details Columns of a color have disjoint rows, so each row of the perturbed
+     *          source belongs to at most one perturbed species.
+     */
+    template<typename S>
+    void coloredSourceJacobian(const S& C, double T, const S& omega, double scale,
+                               const std::vector<int>& colptrs, const std::vector<int>& rowvals,
+                               const std::vector<int>& color_ptrs, const std::vector<int>& color_cols,
+                               std::vector<double>& dwdC)
+    {
+        double Csum = 0.0;
+        for(int j = 0; j + 1 < static_cast<int>(colptrs.size()); j++)
+        {
+            Csum += C[j];
+        }
+
+        S C_pert = C;
+        S dC;
+        for(int c = 0; c + 1 < static_cast<int>(color_ptrs.size()); c++)
+        {
+            for(int m = color_ptrs[c]; m < color_ptrs[c + 1]; m++)
+            {
+                int j     = color_cols[m];
+                dC[j]     = SQRT_EPS * std::max(std::fabs(C[j]), SQRT_EPS * Csum);
+                C_pert[j] = C[j] + dC[j];
+            }
+
+            S omega_p = source_species(C_pert, T);
+
+            for(int m = color_ptrs[c]; m < color_ptrs[c + 1]; m++)
+            {
+                int j     = color_cols[m];
+                C_pert[j] = C[j];
+                for(int k = colptrs[j]; k < colptrs[j + 1]; k++)
+                {
+                    int i   = rowvals[k];
+                    dwdC[k] = (scale * omega_p[i] - omega[i]) / dC[j];
+                }
+            }
+        }
+    }
+
+
+    /**
+     * @brief Dense d(omega)/dC: source_jacobian() when available, otherwise one
+     *        source_species() call per species.
+     * @param[in] C Concentrations.
+     * @param[in] T Temperature [K] (held fixed).
+     * @param[in] omega Production rates at (C, T), already scaled by @p scale.
+     * @param[in] scale Rate multiplier.
+     * @param[in] n Number of species.
+     * @param[out] dwdC Column-major n x n: d(omega_i)/d(C_j) at dwdC[j*n + i].
+     * @return true if the entries are exact.
+     * @details Same step as coloredSourceJacobian(), so the two agree column by column.
+     */
+    template<typename S>
+    bool denseSourceJacobian(const S& C, double T, const S& omega, double scale, int n, double* dwdC)
+    {
+        if constexpr (hasSourceJacobian<S>)
+        {
+            auto J = source_jacobian(C, T);
+            for(int j = 0; j < n; j++)
+            {
+                for(int i = 0; i < n; i++)
+                {
+                    dwdC[j * n + i] = scale * J[i][j];
+                }
+            }
+            return true;
+        }
+        else
+        {
+            double Csum = 0.0;
+            for(int i = 0; i < n; i++)
+            {
+                Csum += C[i];
+            }
+
+            S C_pert = C;
+            for(int j = 0; j < n; j++)
+            {
+                double dC = SQRT_EPS * std::max(std::fabs(C[j]), SQRT_EPS * Csum);
+                C_pert[j] = C[j] + dC;
+                S omega_p = source_species(C_pert, T);
+                C_pert[j] = C[j];
+
+                for(int i = 0; i < n; i++)
+                {
+                    dwdC[j * n + i] = (scale * omega_p[i] - omega[i]) / dC;
+                }
+            }
+            return false;
+        }
+    }
+
+
+    /**
+     * @brief d(omega)/dT by a one-sided difference quotient.
+     * @param[in] C Concentrations.
+     * @param[in] T Temperature [K].
+     * @param[in] omega Production rates at (C, T), already scaled by @p scale.
+     * @param[in] scale Rate multiplier.
+     * @param[in] n Number of species.
+     * @param[in] fixedMassFractions Hold Y (concentrations scale as 1/T at constant
+     *            pressure) instead of C.
+     * @param[out] dwdT Derivative (length @p n).
+     */
+    template<typename S>
+    void sourceTemperatureDerivative(const S& C, double T, const S& omega, double scale, int n,
+                                     bool fixedMassFractions, double* dwdT)
+    {
+        double dT     = SQRT_EPS * T;
+        double Tp     = T + dT;
+        S      C_pert = C;
+        if(fixedMassFractions)
+        {
+            for(int i = 0; i < n; i++)
+            {
+                C_pert[i] = C[i] * T / Tp;
+            }
+        }
+
+        S omega_p = source_species(C_pert, Tp);
+        for(int i = 0; i < n; i++)
+        {
+            dwdT[i] = (scale * omega_p[i] - omega[i]) / dT;
+        }
+    }
+
+
+    /**
+     * @brief Exact d(cp_bar)/dT from chemgen's mass-specific cp derivative.
+     * @param[in] T Temperature [K].
+     * @param[in] MW Molecular weights (length @p n).
+     * @param[in] n Number of species.
+     * @param[out] dcp_bardT Derivative of the molar cp (length @p n).
+     */
+    inline void specificHeatTemperatureDerivative(double T, const double* MW, int n, double* dcp_bardT)
+    {
+        auto dcpdT = dspecies_specific_heat_constant_pressure_mass_specific_dtemperature(T);
+        for(int i = 0; i < n; i++)
+        {
+            dcp_bardT[i] = dcpdT[i] * MW[i];
+        }
+    }
+}
+
+
+#endif /* SRC_REACTOR_CHEMGEN_JACOBIAN */
@@ -26,18 +26,38 @@
 #include "source.h"
 #include "chemical_state_functions.h"
 
+#include "ChemgenJacobian.h"                                                    /* After chemgen: shared d(omega)/dC, d(omega)/dT, d(cp)/dT */
+
+/* ------------------------------------------------------------------------------------------------
+ * Static Functions
+ * ------------------------------------------------------------------------------------------------ */
+
 /* ------------------------------------------------------------------------------------------------
  * Public Functions
  * ------------------------------------------------------------------------------------------------ */
 
-IdealGasConstPressureAdiabaticReactor::IdealGasConstPressureAdiabaticReactor(int n, double temperature, double pressure)
+IdealGasConstPressureAdiabaticReactor::IdealGasConstPressureAdiabaticReactor(int n, double temperature, double pressure,
+                                                                             ThermoMode thermoMode, double thermoRtol, int debug)
 {
+    int n_chemgen = static_cast<int>(sizeof(Species) / sizeof(double));
+    if(n != n_chemgen)                                                          /* Species arrays are fixed-size */
+    {
+        throw std::invalid_argument("IdealGasConstPressureAdiabaticReactor: built with " + std::to_string(n)
+                                    + " species but the chemgen mechanism has " + std::to_string(n_chemgen));
+    }
+
     n_species_ = n;
+    debug_     = debug;
     T_         = temperature;
     P_         = pressure;
     MW_        = molecular_weights();                                           /* TODO: Document data source for MW_ */
     N_         = 0;
     D_         = 0;
+    rate_multiplier_ = 1.0;
+    thermo_T_  = std::numeric_limits<double>::quiet_NaN();
+    omega_T_   = std::numeric_limits<double>::quiet_NaN();
+    thermo_    = &NASA7Thermo::chemgen(n_species_, &MW_[0]);                    /* Falls back to chemgen thermo if invalid */
+    setThermoMode(thermoMode, thermoRtol);
     double temp= 0;
     computeThermoProperties();
 
@@ -59,6 +79,20 @@ IdealGasConstPressureAdiabaticReactor::IdealGasConstPressureAdiabaticReactor(int
     }
 
     computeProductionRates();
+
+    computeSparsityPattern();
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::setThermoMode(ThermoMode thermoMode, double thermoRtol)
+{
+    table_ = ThermoTable();
+    if(thermoMode != ThermoMode::Exact)
+    {
+        table_ = ThermoTable(n_species_, &MW_[0], thermoMode, thermoRtol,
+                             [this](double T, double* cp_bar, double* h_bar) { computeExactThermo(T, cp_bar, h_bar); });
+    }
+    thermo_T_ = std::numeric_limits<double>::quiet_NaN();                       /* cp_, h_ came from the old mode */
 }
 
 
@@ -81,14 +115,13 @@ void IdealGasConstPressureAdiabaticReactor::getdTtDenominator()
 }
 
 
-int IdealGasConstPressureAdiabaticReactor::setNEQ()
+int IdealGasConstPressureAdiabaticReactor::setNEQ() const
 {
-    //return(n_species_ + 1);
-    return(n_species_);
+    return(n_species_ + 1);                                                      /* [T, Y1..Y_N] */
 }
 
 
-void IdealGasConstPressureAdiabaticReactor::setInitialState(double* y)
+void IdealGasConstPressureAdiabaticReactor::setInitialState(double* y) const
 {
     /* Temperature */
     // y[0] = ChemConfig::TEMP0;
@@ -118,55 +151,200 @@ void IdealGasConstPressureAdiabaticReactor::setState(double* y, double temperatu
 }
 
 
+void IdealGasConstPressureAdiabaticReactor::setCellState(double temperature, double pressure, const double* Y)
+{
+    double temp = 0;
+
+    T_ = temperature;
+    P_ = pressure;
+
+    for(int i = 0; i < n_species_ ; i++) 
+    {
+        Y_[i] = Y[i];
+        temp += Y_[i] / MW_[i];
+    }
+    MWtot_ = 1 / temp;
+
+    for(int i = 0; i < n_species_ ; i++) 
+    {
+        C_[i] = (P_ * MWtot_ * Y_[i]) / (ChemConfig::Ru * T_ * MW_[i]);
+    }
+
+    getProperties();
+}
+
+
 void IdealGasConstPressureAdiabaticReactor::evalRHS(double t, double* y, double* ydot)
 {
-    /* Local aliases (non-owning) */
-    double temp       = y[0];
-    double *massFracs = &y[1];                                                  
-    double *dTdt      = &ydot[0];
-    double *dYdt      = &ydot[1];
-            
     /* Update internal state from external vector */
-    // setState(y, y[0]);
-    setState(y, temp); 
+    setState(y, y[0]);
             
     /* Refresh properties (thermo + kinetics) */   
     getProperties();
 
-    /* ---------------- Energy equation ---------------- */
-    N_ = 0.0;
-    D_ = 0.0;
-    for(int i = 0; i < n_species_; i++)
+    assembleRHS(T_, P_, MWtot_, Y_, cp_bar_, h_bar_, omega_, ydot, N_, D_);
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::setCellState(double temperature, double pressure, const double* Y,
+                                                         ReactorWorkspace& ws) const
+{
+    double temp = 0;
+
+    ws.T = temperature;
+    ws.P = pressure;
+
+    for(int i = 0; i < n_species_ ; i++) 
     {
-        N_ += -h_bar_[i] * omega_[i];                                           /* TODO: Sign convention and units */
-        D_ += ((Y_[i] * P_ * MWtot_) * cp_bar_[i]) / (ChemConfig::Ru * T_ * MW_[i]);
+        ws.Y[i] = Y[i];
+        temp   += ws.Y[i] / MW_[i];
     }
-    *dTdt = N_ / D_;
-    
-    /* ---------------- Species equations ---------------- */
-    double omega_sum            = 0.0;
-    double omega_temp           = 0.0;
-    double concentration_sum    = 0.0;
-    double concentration        = 0.0;                                          /* TODO:  Remove if unused */
+    ws.MWtot = 1 / temp;
 
-    for(int i = 0; i < n_species_; i++)
+    for(int i = 0; i < n_species_ ; i++) 
     {
-        omega_sum         += omega_[i];
-        concentration_sum += (Y_[i] * P_ * MWtot_) / (ChemConfig::Ru * T_ * MW_[i]);
+        ws.C[i] = (ws.P * ws.MWtot * ws.Y[i]) / (ChemConfig::Ru * ws.T * MW_[i]);
     }
-    
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evalRHS(double t, const double* y, double* ydot, ReactorWorkspace& ws) const
+{
+    double N, D;
+
+    /* Same update as setState(): MWtot stays at its setCellState() value */
+    ws.T = y[0];
     for(int i = 0; i < n_species_; i++)
     {
-        /* Note: indices are 0-based for internal arrays */
-        // omega_temp   = omega_[i - 1] * (MW_[i - 1] * ChemConfig::Ru * T_) / (P_ * MWtot_);
-        // ydot[i]      = omega_temp - Y_[i - 1] * ((omega_sum / concentration_sum) + (*dTdt / T_));
-        omega_temp   = omega_[i] * (MW_[i] * ChemConfig::Ru * T_) / (P_ * MWtot_); 
-        dYdt[i]      = omega_temp - Y_[i] * ((omega_sum / concentration_sum) + (*dTdt / T_));
+        ws.Y[i] = y[i + 1];
+        ws.C[i] = (ws.P * ws.MWtot * ws.Y[i]) / (ChemConfig::Ru * ws.T * MW_[i]);
+    }
+
+    if(ws.T != ws.thermo_T)
+    {
+        evaluateThermo(ws.T, &ws.cp_bar[0], &ws.h_bar[0], &ws.cp[0], &ws.h[0]);
+        ws.thermo_T = ws.T;
+    }
+    evaluateProductionRates(ws.C, ws.T, ws.omega);
+
+    assembleRHS(ws.T, ws.P, ws.MWtot, ws.Y, ws.cp_bar, ws.h_bar, ws.omega, ydot, N, D);
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evalJacobian(double t, double* y, double* ydot, double* J)
+{
+    int neq = setNEQ();
+
+    prepareJacobian(y, ydot);
+
+    for(int j = 0; j < neq; j++)
+    {
+        computeJacobianColumn(j, &J[j * neq]);
     }
 }
 
 
-double IdealGasConstPressureAdiabaticReactor::getTemperature()
+void IdealGasConstPressureAdiabaticReactor::getJacobianPattern(std::vector<int>& colptrs, std::vector<int>& rowvals)
+{
+    colptrs = jac_colptrs_;
+    rowvals = jac_rowvals_;
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evalSparseJacobian(double t, double* y, double* ydot, double* data)
+{
+    int neq = setNEQ();
+
+    prepareJacobian(y, ydot);
+
+    for(int j = 0; j < neq; j++)
+    {
+        computeJacobianColumn(j, jcol_.data());
+
+        for(int k = jac_colptrs_[j]; k < jac_colptrs_[j + 1]; k++)
+        {
+            data[k] = jcol_[jac_rowvals_[k]];
+        }
+    }
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evalJacobianArrowhead(double t, double* y, double* ydot, 
+                                                                  double* diag, double* row0, double* col0)
+{
+    /* d(omega)/dC is the only part costing more than two source_species() calls */
+    bool species_columns = ChemgenJacobian::hasSourceJacobian<Species> || dwdC_age_ >= ChemConfig::PREC_KINETIC_LAG;
+    prepareJacobian(y, ydot, species_columns);
+    dwdC_age_++;
+
+    /* Temperature column in full */
+    computeJacobianColumn(0, col0);
+    diag[0] = col0[0];
+    row0[0] = col0[0];
+
+    /* Temperature row and species diagonal, see computeJacobianColumn() */
+    for(int s = 0; s < n_species_; s++)
+    {
+        double dCs  = jacK_ / MW_[s];
+        double dN   = 0.0;
+        double dS   = 0.0;
+        double dwss = 0.0;                                                      /* Self term d(omega_s)/d(Y_s) */
+
+        for(int k = kin_colptrs_[s]; k < kin_colptrs_[s + 1]; k++)
+        {
+            int    i  = kin_rowvals_[k];
+            double dw = dwdC_[k] * dCs;
+            dN += -h_bar_[i] * dw;
+            dS += dw;
+            if(i == s)
+            {
+                dwss = dw;
+            }
+        }
+        double dD = dCs * cp_bar_[s];
+
+        double dTdotdY = (dN - jacdTdt_ * dD) / jacD_;
+        double dphidY  = (dS - (jacS_ / jacCsum_) * dCs) / jacCsum_ + dTdotdY / T_;
+
+        row0[s + 1] = dTdotdY;
+        diag[s + 1] = dwss * MW_[s] / jacK_ - Y_[s] * dphidY - jacphi_;
+    }
+}
+
+
+int IdealGasConstPressureAdiabaticReactor::getNumParameters()
+{
+    return 1;
+}
+
+
+double* IdealGasConstPressureAdiabaticReactor::getParameters()
+{
+    return &rate_multiplier_;
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evalParameterDerivative(double t, double* y, double* ydot, int k, double* dfdp)
+{
+    int neq = setNEQ();
+
+    if(rate_multiplier_ != 0.0)
+    {
+        for(int i = 0; i < neq; i++)
+        {
+            dfdp[i] = ydot[i] / rate_multiplier_;
+        }
+        return;
+    }
+
+    /* p = 0: ydot vanishes, d(ydot)/dp is the RHS at p = 1 */
+    rate_multiplier_ = 1.0;
+    evalRHS(t, y, dfdp);
+    rate_multiplier_ = 0.0;
+}
+
+
+double IdealGasConstPressureAdiabaticReactor::getTemperature() const
 {
     return T_;
 }
@@ -178,7 +356,7 @@ double IdealGasConstPressureAdiabaticReactor::getNumberofSpecies()
 }
 
 
-double IdealGasConstPressureAdiabaticReactor::getPressure()
+double IdealGasConstPressureAdiabaticReactor::getPressure() const
 {
     return P_;
 }
@@ -216,25 +394,517 @@ void IdealGasConstPressureAdiabaticReactor::getomega()
 }
 
 
+int IdealGasConstPressureAdiabaticReactor::getNumberofColors() const
+{
+    return static_cast<int>(color_ptrs_.size()) - 1;
+}
+
+
 /* ------------------------------------------------------------------------------------------------
  * Private Functions
  * ------------------------------------------------------------------------------------------------ */
 
 void IdealGasConstPressureAdiabaticReactor::computeThermoProperties()
 {
-     cp_  = species_specific_heat_constant_pressure_mass_specific(T_);
-     h_   = species_enthalpy_mass_specific(T_);
+    if(T_ == thermo_T_)
+    {
+        return;                                                                 /* Same T: NASA polynomials unchanged */
+    }
+
+    evaluateThermo(T_, &cp_bar_[0], &h_bar_[0], &cp_[0], &h_[0]);
+    thermo_T_ = T_;
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evaluateThermo(double T, double* cp_bar, double* h_bar,
+                                                           double* cp, double* h) const
+{
+     if(table_.evaluate(T, cp_bar, h_bar, cp, h))
+     {
+         return;                                                                /* Outside the table: exact path below */
+     }
+
+     if(thermo_->isValid())
+     {
+         thermo_->evaluate(T, cp_bar, h_bar, cp, h);                             /* One fused pass */
+         return;
+     }
+
+     Species cp_s = species_specific_heat_constant_pressure_mass_specific(T);
+     Species h_s  = species_enthalpy_mass_specific(T);
      for(int i = 0; i < n_species_ ; i++)
      {
-         cp_bar_[i]  = cp_[i] * MW_[i];
-         h_bar_[i]   = h_[i]  * MW_[i];
+         cp[i]      = cp_s[i];
+         h[i]       = h_s[i];
+         cp_bar[i]  = cp_s[i] * MW_[i];
+         h_bar[i]   = h_s[i]  * MW_[i];
      }
 }
 
 
+void IdealGasConstPressureAdiabaticReactor::computeExactThermo(double T, double* cp_bar, double* h_bar) const
+{
+    if(thermo_->isValid())
+    {
+        Species cp, h;
+        thermo_->evaluate(T, cp_bar, h_bar, &cp[0], &h[0]);
+        return;
+    }
+
+    Species cp = species_specific_heat_constant_pressure_mass_specific(T);
+    Species h  = species_enthalpy_mass_specific(T);
+    for(int i = 0; i < n_species_; i++)
+    {
+        cp_bar[i] = cp[i] * MW_[i];
+        h_bar[i]  = h[i]  * MW_[i];
+    }
+}
+
+
 void IdealGasConstPressureAdiabaticReactor::computeProductionRates()
 {
-    omega_ = source_species(C_, T_);
+    if(T_ == omega_T_ && C_ == omega_C_ && rate_multiplier_ == omega_p_)
+    {
+        return;                                                                 /* Jacobian at the state of the last RHS */
+    }
+
+    evaluateProductionRates(C_, T_, omega_);
+    omega_T_ = T_;
+    omega_C_ = C_;
+    omega_p_ = rate_multiplier_;
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::evaluateProductionRates(const Species& C, double T, Species& omega) const
+{
+    omega = source_species(C, T);
+
+    if(rate_multiplier_ != 1.0)
+    {
+        for(int i = 0; i < n_species_; i++)
+        {
+            omega[i] *= rate_multiplier_;
+        }
+    }
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::assembleRHS(double T, double P, double MWtot, const Species& Y,
+                                                        const Species& cp_bar, const Species& h_bar,
+                                                        const Species& omega, double* ydot, double& N, double& D) const
+{
+    double *dTdt = &ydot[0];
+    double *dYdt = &ydot[1];
+
+    /* ---------------- Energy equation ---------------- */
+    N = 0.0;
+    D = 0.0;
+    for(int i = 0; i < n_species_; i++)
+    {
+        N += -h_bar[i] * omega[i];                                              /* TODO: Sign convention and units */
+        D += ((Y[i] * P * MWtot) * cp_bar[i]) / (ChemConfig::Ru * T * MW_[i]);
+    }
+    *dTdt = N / D;
+    
+    /* ---------------- Species equations ---------------- */
+    double omega_sum            = 0.0;
+    double omega_temp           = 0.0;
+    double concentration_sum    = 0.0;
+
+    for(int i = 0; i < n_species_; i++)
+    {
+        omega_sum         += omega[i];
+        concentration_sum += (Y[i] * P * MWtot) / (ChemConfig::Ru * T * MW_[i]);
+    }
+    
+    for(int i = 0; i < n_species_; i++)
+    {
+        omega_temp   = omega[i] * (MW_[i] * ChemConfig::Ru * T) / (P * MWtot); 
+        dYdt[i]      = omega_temp - Y[i] * ((omega_sum / concentration_sum) + (*dTdt / T));
+    }
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::computeKineticJacobian(bool speciesColumns)
+{
+    /* d(omega)/dC: exact from chemgen when available, otherwise one source_species()
+     * call per color, temperature held fixed */
+    if(speciesColumns)
+    {
+        if(!ChemgenJacobian::sourceJacobian(C_, T_, rate_multiplier_, kin_colptrs_, kin_rowvals_, dwdC_))
+        {
+            ChemgenJacobian::coloredSourceJacobian(C_, T_, omega_, rate_multiplier_, kin_colptrs_, kin_rowvals_,
+                                                   color_ptrs_, color_cols_, dwdC_);
+        }
+        if(!kin_verified_)
+        {
+            verifyKineticPattern();                                             /* Once per pattern */
+        }
+        dwdC_age_ = 0;
+    }
+
+    /* d(omega)/dT at fixed Y: concentrations scale as 1/T at constant pressure */
+    ChemgenJacobian::sourceTemperatureDerivative(C_, T_, omega_, rate_multiplier_, n_species_, true, &dwdT_[0]);
+
+    if(table_.evaluateCpDerivative(T_, &dcp_bardT_[0]))
+    {
+        return;                                                                 /* Slope of the same table cp_bar_ came from */
+    }
+
+    if(thermo_->isValid())
+    {
+        thermo_->evaluateCpDerivative(T_, &dcp_bardT_[0]);                      /* Exact, no extra thermo pass */
+        return;
+    }
+
+    ChemgenJacobian::specificHeatTemperatureDerivative(T_, &MW_[0], n_species_, &dcp_bardT_[0]);
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::computeSparsityPattern()
+{
+    /* A species j couples to i if d(omega_i)/d(C_j) is nonzero at any of the probes:
+     * positive compositions, log-uniform over six decades of the total concentration,
+     * at temperatures spread over 800-2800 K. Every reaction is active at such a
+     * point, and an exact cancellation between two reactions' contributions or a
+     * contribution lost to rounding against the others would have to recur at every
+     * probe. The fixed seed keeps the pattern identical from run to run. */
+    std::vector<std::vector<int>> kin_rows(n_species_);
+    for(int j = 0; j < n_species_; j++)
+    {
+        kin_rows[j].push_back(j);                                               /* Diagonal always kept */
+    }
+
+    std::vector<int>    dense_colptrs(n_species_ + 1);
+    std::vector<int>    dense_rowvals(n_species_ * n_species_);
+    std::vector<double> dense_J(n_species_ * n_species_);
+    for(int j = 0; j < n_species_; j++)
+    {
+        dense_colptrs[j + 1] = (j + 1) * n_species_;
+        for(int i = 0; i < n_species_; i++)
+        {
+            dense_rowvals[j * n_species_ + i] = i;
+        }
+    }
+
+    std::mt19937                           rng;
+    std::uniform_real_distribution<double> decades(-6.0, 0.0);
+    Species                                C_probe;
+
+    for(int p = 0; p < ChemConfig::SPARSITY_PROBES; p++)
+    {
+        double Tp   = 800.0 + 2000.0 * (p + 0.5) / ChemConfig::SPARSITY_PROBES;
+        double Ctot = ChemConfig::p0 / (ChemConfig::Ru * Tp);
+        for(int i = 0; i < n_species_; i++)
+        {
+            C_probe[i] = Ctot * std::pow(10.0, decades(rng));
+        }
+
+        if(ChemgenJacobian::sourceJacobian(C_probe, Tp, 1.0, dense_colptrs, dense_rowvals, dense_J))
+        {
+            for(int j = 0; j < n_species_; j++)
+            {
+                for(int i = 0; i < n_species_; i++)
+                {
+                    if(dense_J[j * n_species_ + i] != 0.0)
+                    {
+                        kin_rows[j].push_back(i);
+                    }
+                }
+            }
+            continue;
+        }
+
+        /* No chemgen Jacobian: doubling C_j is far above rounding of omega */
+        Species omega_0 = source_species(C_probe, Tp);
+        for(int j = 0; j < n_species_; j++)
+        {
+            double Cj       = C_probe[j];
+            C_probe[j]      = 2.0 * Cj;
+            Species omega_p = source_species(C_probe, Tp);
+            C_probe[j]      = Cj;
+
+            for(int i = 0; i < n_species_; i++)
+            {
+                if(omega_p[i] != omega_0[i])
+                {
+                    kin_rows[j].push_back(i);
+                }
+            }
+        }
+    }
+
+    setKineticPattern(kin_rows);
+
+    /* Full state Jacobian [T, Y1..Y_N] in CSC form. The T column is dense. The
+     * dilatation term -Y_i * d(phi)/dY_j reaches every species row, so with
+     * ChemConfig::SPARSE_DILATATION each Y_j column is dense too and the sparse
+     * Jacobian is exact; without it a Y_j column holds the T row plus the kinetic
+     * rows of species j (shifted by one) and the rest of the term is dropped. */
+    int neq = setNEQ();
+    jac_colptrs_.assign(1, 0);
+    jac_rowvals_.clear();
+    for(int i = 0; i < neq; i++)
+    {
+        jac_rowvals_.push_back(i);
+    }
+    jac_colptrs_.push_back(jac_rowvals_.size());
+
+    for(int j = 0; j < n_species_; j++)
+    {
+        if(ChemConfig::SPARSE_DILATATION)
+        {
+            for(int i = 0; i < neq; i++)
+            {
+                jac_rowvals_.push_back(i);
+            }
+        }
+        else
+        {
+            jac_rowvals_.push_back(0);
+            for(int k = kin_colptrs_[j]; k < kin_colptrs_[j + 1]; k++)
+            {
+                jac_rowvals_.push_back(kin_rowvals_[k] + 1);
+            }
+        }
+        jac_colptrs_.push_back(jac_rowvals_.size());
+    }
+
+    jcol_.assign(neq, 0.0);
+
+    colorKineticPattern();
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::setKineticPattern(std::vector<std::vector<int>>& kin_rows)
+{
+    kin_colptrs_.assign(1, 0);
+    kin_rowvals_.clear();
+    for(int j = 0; j < n_species_; j++)
+    {
+        std::sort(kin_rows[j].begin(), kin_rows[j].end());
+        kin_rows[j].erase(std::unique(kin_rows[j].begin(), kin_rows[j].end()), kin_rows[j].end());
+        kin_rowvals_.insert(kin_rowvals_.end(), kin_rows[j].begin(), kin_rows[j].end());
+        kin_colptrs_.push_back(kin_rowvals_.size());
+    }
+    dwdC_.assign(kin_rowvals_.size(), 0.0);
+    kin_verified_ = false;                                                      /* Checked at the next computeKineticJacobian() */
+    dwdC_age_     = ChemConfig::PREC_KINETIC_LAG;                               /* Zeroed values, never reused */
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::verifyKineticPattern()
+{
+    const double mix_rtol = 1.0e-6;                                             /* Compressed vs. plain, relative to the column */
+
+    /* Uncompressed d(omega)/dC at the current state: the full source_jacobian(),
+     * or one source_species() call per species with the step of computeKineticJacobian() */
+    std::vector<double> full(n_species_ * n_species_);
+    ChemgenJacobian::denseSourceJacobian(C_, T_, omega_, rate_multiplier_, n_species_, full.data());
+
+    /* Nonzeros off the pattern were missed by the probes (and leak into other
+     * columns of their color); a mismatch on it means the coloring mixed columns */
+    std::vector<std::vector<int>> kin_rows(n_species_);
+    std::vector<char>             on_pattern(n_species_);
+    int                           missed = 0;
+    bool                          mixed  = false;
+
+    for(int j = 0; j < n_species_; j++)
+    {
+        const double* u     = &full[j * n_species_];
+        double        scale = 0.0;
+        for(int i = 0; i < n_species_; i++)
+        {
+            scale         = std::max(scale, std::fabs(u[i]));
+            on_pattern[i] = 0;
+        }
+
+        for(int k = kin_colptrs_[j]; k < kin_colptrs_[j + 1]; k++)
+        {
+            int i         = kin_rowvals_[k];
+            on_pattern[i] = 1;
+            kin_rows[j].push_back(i);
+            mixed         = mixed || std::fabs(u[i] - dwdC_[k]) > mix_rtol * scale;
+        }
+        for(int i = 0; i < n_species_; i++)
+        {
+            if(!on_pattern[i] && u[i] != 0.0)
+            {
+                kin_rows[j].push_back(i);
+                missed++;
+            }
+        }
+    }
+
+    if(missed == 0 && !mixed)
+    {
+        kin_verified_ = true;
+        return;
+    }
+
+    /* Use the uncompressed values now, and a pattern that holds them from here on */
+    setKineticPattern(kin_rows);
+    for(int j = 0; j < n_species_; j++)
+    {
+        for(int k = kin_colptrs_[j]; k < kin_colptrs_[j + 1]; k++)
+        {
+            dwdC_[k] = full[j * n_species_ + kin_rowvals_[k]];
+        }
+    }
+
+    if(missed > 0)
+    {
+        colorKineticPattern();
+    }
+    else
+    {
+        color_ptrs_.resize(n_species_ + 1);                                     /* One species per color */
+        color_cols_.resize(n_species_);
+        for(int j = 0; j < n_species_; j++)
+        {
+            color_ptrs_[j + 1] = j + 1;
+            color_cols_[j]     = j;
+        }
+    }
+    kin_verified_ = true;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Kinetic Jacobian pattern check: "<<missed<<" missed couplings"
+                 <<(missed > 0 ? ", recolored" : ", coloring disabled")<<std::endl;
+    }
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::colorKineticPattern()
+{
+    /* Greedy column coloring of d(omega)/dC, largest column first */
+    std::vector<int> order(n_species_);
+    for(int j = 0; j < n_species_; j++)
+    {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b)
+    {
+        return (kin_colptrs_[a + 1] - kin_colptrs_[a]) > (kin_colptrs_[b + 1] - kin_colptrs_[b]);
+    });
+
+    std::vector<std::vector<char>> rows_used;                                   /* Rows already hit, per color */
+    std::vector<std::vector<int>>  groups;
+    for(int j : order)
+    {
+        int c = 0;
+        for(; c < static_cast<int>(groups.size()); c++)
+        {
+            bool fits = true;
+            for(int k = kin_colptrs_[j]; k < kin_colptrs_[j + 1] && fits; k++)
+            {
+                fits = !rows_used[c][kin_rowvals_[k]];
+            }
+            if(fits)
+            {
+                break;
+            }
+        }
+        if(c == static_cast<int>(groups.size()))
+        {
+            rows_used.emplace_back(n_species_, 0);
+            groups.emplace_back();
+        }
+
+        groups[c].push_back(j);
+        for(int k = kin_colptrs_[j]; k < kin_colptrs_[j + 1]; k++)
+        {
+            rows_used[c][kin_rowvals_[k]] = 1;
+        }
+    }
+
+    color_ptrs_.assign(1, 0);
+    color_cols_.clear();
+    for(const std::vector<int>& g : groups)
+    {
+        color_cols_.insert(color_cols_.end(), g.begin(), g.end());
+        color_ptrs_.push_back(color_cols_.size());
+    }
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::prepareJacobian(double* y, double* ydot, bool speciesColumns)
+{
+    /* Update internal state and derivatives at y */
+    setState(y, y[0]);
+    getProperties();
+    computeKineticJacobian(speciesColumns);
+
+    /* Shorthands, see evalRHS(): C_i = K * Y_i / MW_i */
+    jacK_    = (P_ * MWtot_) / (ChemConfig::Ru * T_);
+    jacS_    = 0.0;
+    jacCsum_ = 0.0;
+    jacD_    = 0.0;
+
+    for(int i = 0; i < n_species_; i++)
+    {
+        jacS_    += omega_[i];
+        jacCsum_ += C_[i];
+        jacD_    += C_[i] * cp_bar_[i];
+    }
+    jacdTdt_ = ydot[0];
+    jacphi_  = (jacS_ / jacCsum_) + (jacdTdt_ / T_);
+}
+
+
+void IdealGasConstPressureAdiabaticReactor::computeJacobianColumn(int j, double* col)
+{
+    double dN = 0.0;
+    double dD = 0.0;
+    double dS = 0.0;
+
+    /* ---------------- Column 0: d/dT at fixed Y ---------------- */
+    if(j == 0)
+    {
+        for(int i = 0; i < n_species_; i++)
+        {
+            dN += -(cp_bar_[i] * omega_[i] + h_bar_[i] * dwdT_[i]);
+            dD += C_[i] * (dcp_bardT_[i] - cp_bar_[i] / T_);
+            dS += dwdT_[i];
+        }
+        double dTdotdT = (dN - jacdTdt_ * dD) / jacD_;
+        double dphidT  = (dS + jacS_ / T_) / jacCsum_ + (dTdotdT - jacdTdt_ / T_) / T_;
+
+        col[0] = dTdotdT;
+        for(int i = 0; i < n_species_; i++)
+        {
+            col[i + 1] = MW_[i] * (omega_[i] / T_ + dwdT_[i]) / jacK_ - Y_[i] * dphidT;
+        }
+        return;
+    }
+
+    /* ---------------- Columns 1..N: d/dY_s at fixed T ---------------- */
+    int    s   = j - 1;
+    double dCs = jacK_ / MW_[s];                                                /* d(C_s)/d(Y_s) */
+
+    for(int i = 0; i < n_species_; i++)
+    {
+        dwdY_[i] = 0.0;
+    }
+    for(int k = kin_colptrs_[s]; k < kin_colptrs_[s + 1]; k++)
+    {
+        int i    = kin_rowvals_[k];
+        dwdY_[i] = dwdC_[k] * dCs;
+        dN      += -h_bar_[i] * dwdY_[i];
+        dS      += dwdY_[i];
+    }
+    dD = dCs * cp_bar_[s];
+
+    double dTdotdY = (dN - jacdTdt_ * dD) / jacD_;
+    double dphidY  = (dS - (jacS_ / jacCsum_) * dCs) / jacCsum_ + dTdotdY / T_;
+
+    col[0] = dTdotdY;
+    for(int i = 0; i < n_species_; i++)
+    {
+        col[i + 1] = dwdY_[i] * MW_[i] / jacK_ - Y_[i] * dphidY;
+    }
+    col[s + 1] -= jacphi_;
 }
 
 
@@ -18,10 +18,40 @@
 #include <array>
 #include <algorithm>
 #include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
 
 /* Chemgen header files */
 #include "types_inl.h"  /* For Species */
 
+#include "NASA7Thermo.h"
+#include "ThermoTable.h"
+#include "ChemConfig.h"
+
+/**
+ * @brief Per-cell scratch of the re-entrant (const) reactor entry points.
+ * @details
+ *   Holds everything evalRHS() would otherwise write into the reactor, so one
+ *   reactor (mechanism, MW, thermo kernels) can be shared read-only by any number
+ *   of cells and threads, each with its own workspace.
+ */
+struct ReactorWorkspace
+{
+    double  T      = 0.0;    ///< Temperature [K].
+    double  P      = 0.0;    ///< Pressure [Pa] of the cell.
+    double  MWtot  = 0.0;    ///< Mixture molecular weight, set by setCellState() (as in the member path).
+    Species Y;               ///< Mass fractions.
+    Species C;               ///< Concentrations.
+    Species cp;              ///< Mass-specific cp.
+    Species h;               ///< Mass-specific h.
+    Species cp_bar;          ///< Molar cp.
+    Species h_bar;           ///< Molar h.
+    Species omega;           ///< Net production rates.
+    double  thermo_T = std::numeric_limits<double>::quiet_NaN();  ///< T of cp, h, cp_bar, h_bar (NaN = none yet).
+};
+
+
 /**
  * @class IdealGasConstPressureAdiabaticReactor
  * @brief Constant-pressure, adiabatic reactor model for an ideal-gas mixture.
@@ -36,9 +66,23 @@ class IdealGasConstPressureAdiabaticReactor
          * @param[in] n Number of chemical species in the mixture.
          * @param[in] temperature Initial temperature [K]. (default: 300)
          * @param[in] pressure Initial pressure [Pa]. (default: 101325.0)
-         * @throws (none) TODO: Specify if implementation throws.
+         * @param[in] thermoMode Exact thermo, or a cp/h table built here. (default: Exact)
+         * @param[in] thermoRtol Error bound of the table against the exact path.
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         * @throws std::invalid_argument if @p n differs from the chemgen species count:
+         *         callers size their buffers with @p n, so it cannot be corrected here.
+         */
+        IdealGasConstPressureAdiabaticReactor(int n, double temperature = 300, double pressure = 101325.0,
+                                              ThermoMode thermoMode = ThermoMode::Exact,
+                                              double thermoRtol = ChemConfig::THERMO_TABLE_RTOL, int debug = 0);
+
+        /**
+         * @brief Switch how cp and h are evaluated; builds (or drops) the table.
+         * @param[in] thermoMode Exact thermo, or a cp/h table built here.
+         * @param[in] thermoRtol Error bound of the table against the exact path.
+         * @post Properties are re-evaluated at the next RHS or getProperties().
          */
-        IdealGasConstPressureAdiabaticReactor(int n, double temperature = 300, double pressure = 101325.0);
+        void setThermoMode(ThermoMode thermoMode, double thermoRtol = ChemConfig::THERMO_TABLE_RTOL);
     
         /**
          * @brief Refresh thermodynamic and kinetic properties for current state.
@@ -67,7 +111,7 @@ class IdealGasConstPressureAdiabaticReactor
          * @return Number of equations (state dimension).
          * @note Typically 1 (temperature) + number of species for mass fractions.
          */
-        int setNEQ();
+        int setNEQ() const;
     
         /**
          * @brief Populate an external state vector with the initial condition.
@@ -75,7 +119,7 @@ class IdealGasConstPressureAdiabaticReactor
          * @pre @p y is valid and has length = setNEQ().
          * @post @p y contains initial states of @ref T_ and @ref Y_.
          */
-        void setInitialState(double* y);
+        void setInitialState(double* y) const;
     
         /**
          * @brief Replace internal state from an external vector and temperature.
@@ -86,6 +130,16 @@ class IdealGasConstPressureAdiabaticReactor
          * @post Internal @ref T_, @ref Y_, and @ref C_ updated.
          */
         void setState(double* y, double temperature);
+
+        /**
+         * @brief Reset the reactor to a new cell state.
+         * @param[in] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa].
+         * @param[in] Y Mass fractions (length = number of species).
+         * @post @ref T_, @ref P_, @ref Y_, @ref MWtot_, @ref C_ and properties updated;
+         *       setInitialState() returns this state.
+         */
+        void setCellState(double temperature, double pressure, const double* Y);
     
         /**
          * @brief Evaluate ODE right-hand side (RHS): dT/dt and dY/dt.
@@ -98,6 +152,126 @@ class IdealGasConstPressureAdiabaticReactor
          * @post @p ydot populated for integrator.
          */
         void evalRHS(double t, double* y, double* ydot);
+
+        /**
+         * @brief Load a cell state into a caller-owned workspace (re-entrant).
+         * @param[in] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa].
+         * @param[in] Y Mass fractions (length = number of species).
+         * @param[out] ws Workspace of the cell.
+         * @note Does not touch the reactor; the mirror of setCellState() for the const path.
+         */
+        void setCellState(double temperature, double pressure, const double* Y, ReactorWorkspace& ws) const;
+
+        /**
+         * @brief Evaluate the RHS without modifying the reactor (re-entrant).
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[out] ydot Derivative vector; layout [dT/dt, dY1/dt..dY_N/dt].
+         * @param[in,out] ws Workspace loaded by setCellState(..., ws); all scratch goes here.
+         * @details
+         *   Same result as evalRHS(t, y, ydot) after setCellState() with the same cell.
+         *   Safe to call concurrently on one reactor with distinct workspaces.
+         */
+        void evalRHS(double t, const double* y, double* ydot, ReactorWorkspace& ws) const;
+
+        /**
+         * @brief Evaluate the Jacobian of the RHS, d(ydot)/dy.
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[in] ydot RHS at (t, y), as returned by evalRHS().
+         * @param[out] J Column-major NEQ×NEQ array, J[j*NEQ + i] = d(ydot_i)/d(y_j).
+         * @details
+         *   Semi-analytic: the energy/species algebra of evalRHS() is differentiated
+         *   by hand, the kinetic derivatives are not all exact (see
+         *   computeKineticJacobian()). d(omega)/dC comes from chemgen's source_jacobian()
+         *   when the mechanism provides it, otherwise from a colored difference quotient
+         *   of source_species(); d(omega)/dT is always a difference quotient. NASA thermo
+         *   is evaluated once per Jacobian instead of once per column.
+         * @pre @p y and @p ydot have length setNEQ(); @p J has length setNEQ()^2.
+         */
+        void evalJacobian(double t, double* y, double* ydot, double* J);
+
+        /**
+         * @brief Return the CSC sparsity pattern used by evalSparseJacobian().
+         * @param[out] colptrs Column pointers (length = setNEQ() + 1).
+         * @param[out] rowvals Row indices, sorted within each column.
+         * @details
+         *   The T row and T column are dense. The dilatation term -Y_i * d(phi)/dY_j
+         *   couples every species pair, so with ChemConfig::SPARSE_DILATATION (default)
+         *   the species block is dense as well and evalSparseJacobian() is exact; the
+         *   sparse storage then pays off for block systems such as ReactorBatchAdapter.
+         *   Without it the species block is the pattern of d(omega)/dC found by
+         *   computeSparsityPattern() and the dilatation term is dropped outside it, an
+         *   inexact Newton matrix that keeps KLU's fill low for large mechanisms.
+         */
+        void getJacobianPattern(std::vector<int>& colptrs, std::vector<int>& rowvals);
+
+        /**
+         * @brief Evaluate the Jacobian on the pattern of getJacobianPattern().
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[in] ydot RHS at (t, y), as returned by evalRHS().
+         * @param[out] data Nonzero values, in the order of the pattern's row indices.
+         */
+        void evalSparseJacobian(double t, double* y, double* ydot, double* data);
+
+        /**
+         * @brief Evaluate the T row, T column and diagonal of the Jacobian.
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[in] ydot RHS at (t, y), as returned by evalRHS().
+         * @param[out] diag Diagonal, d(ydot_i)/d(y_i) (length = setNEQ()).
+         * @param[out] row0 d(dT/dt)/d(y_j) (length = setNEQ()).
+         * @param[out] col0 d(ydot_i)/dT (length = setNEQ()).
+         * @details
+         *   The species diagonal is the self-consumption term d(omega_s)/d(C_s) plus the
+         *   dilatation terms. Assembly is O(nnz) time and O(N) memory on top of the
+         *   kinetic derivatives. Those cost one source_jacobian() and one source_species()
+         *   call when chemgen provides source_jacobian(). Otherwise the colored
+         *   d(omega)/dC (one source_species() call per color, as for the dense Jacobian)
+         *   is only refreshed every ChemConfig::PREC_KINETIC_LAG calls; omega, d(omega)/dT,
+         *   thermo and the dilatation terms are refreshed on every call, so a typical setup
+         *   costs two source_species() calls.
+         */
+        void evalJacobianArrowhead(double t, double* y, double* ydot, double* diag, double* row0, double* col0);
+
+        /**
+         * @brief Number of sensitivity parameters: global-rate sensitivity only.
+         * @return 1: one multiplier p on every rate constant, so dy/dp is the sensitivity to a
+         *         uniform scaling of all reactions, not to any single reaction's A-factor.
+         * @note chemgen does expose reaction-level code: reactions.h has one
+         *       call_forward_reaction_k() per reaction (its k_f, with the third-body
+         *       or falloff factor) and arrhenius.h the rate forms and their derivatives.
+         *       But each call_forward_reaction_k() hard-codes its A, beta and E, and
+         *       the reverse rates and stoichiometry exist only inside the generated
+         *       source_species(), which calls all of them with no scaling argument.
+         *       A per-reaction multiplier therefore has to be generated into
+         *       source_species() by chemgen; from here only the common factor of all
+         *       rates, which scales omega itself, can be perturbed.
+         */
+        int getNumParameters();
+
+        /**
+         * @brief Live parameter storage (&@ref rate_multiplier_), read by evalRHS().
+         */
+        double* getParameters();
+
+        /**
+         * @brief Evaluate d(ydot)/d(p_k).
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[in] ydot RHS at (t, y).
+         * @param[in] k Parameter index (only 0).
+         * @param[out] dfdp d(ydot)/d(p_k) (length = setNEQ()).
+         * @details
+         *   Scaling every forward and reverse rate constant by p (both limits of falloff
+         *   reactions included) scales omega by p, and the whole RHS is linear in omega,
+         *   so d(ydot)/dp = ydot / p exactly. The forcing term is this simple; the state
+         *   sensitivity dy/dp that CVODES integrates from it is not (it carries J).
+         */
+        void evalParameterDerivative(double t, double* y, double* ydot, int k, double* dfdp);
+
     
     
         /* ---------------- Debug/Misc accessors ---------------- */
@@ -106,13 +280,13 @@ class IdealGasConstPressureAdiabaticReactor
          * @brief Get current temperature.
          * @return Temperature [K].
          */
-        double getTemperature();
+        double getTemperature() const;
     
         /**
          * @brief Get current pressure.
          * @return Pressure [Pa].
          */
-        double getPressure();
+        double getPressure() const;
     
         /**
          * @brief Get number of species in the mixture.
@@ -138,6 +312,12 @@ class IdealGasConstPressureAdiabaticReactor
          *   @todo Specify units and sign convention.
          */
         void getomega();
+
+        /**
+         * @brief Get number of column colors of d(omega)/dC.
+         * @return source_species() calls per kinetic Jacobian (plus one for T).
+         */
+        int getNumberofColors() const;
     
     
     private:
@@ -145,6 +325,7 @@ class IdealGasConstPressureAdiabaticReactor
     
         double Ctot_;        ///< Total molar concentration [kmol/m^3 or mol/m^3]. @todo Confirm units.
         int    n_species_;   ///< Number of species in the mechanism.
+        int    debug_;       ///< Debug verbosity: 0 = quiet, 1 = prints the kinetic pattern check.
     
         /* ---------------- Thermodynamic state ------------------ */
     
@@ -158,6 +339,9 @@ class IdealGasConstPressureAdiabaticReactor
         Species cp_bar_;     ///< Molar specifc constant-pressure specific heats [J/(mol·K)]. 
         Species h_;          ///< Mass specific enthalpies [J/kg].
         Species h_bar_;      ///< Molar specific enthalpies [J/kmol].
+        const NASA7Thermo *thermo_; ///< Shared cp/h kernel (NASA7Thermo::chemgen()); chemgen thermo is used when it is not valid.
+        ThermoTable table_;  ///< Optional cp/h table, tried before @ref thermo_.
+        double  thermo_T_;   ///< T at which cp_, h_, cp_bar_, h_bar_ were evaluated (NaN = none yet).
     
         /* ---------------- Composition / concentrations --------- */
     
@@ -169,6 +353,33 @@ class IdealGasConstPressureAdiabaticReactor
         /* ---------------- Kinetics ----------------------------- */
     
         Species omega_;      ///< Net production rates [kg/(m^3·s) or mol/(m^3·s)]. @todo Confirm basis and units.
+        double  rate_multiplier_;   ///< Global rate multiplier, the only sensitivity parameter.
+        double  omega_T_;    ///< T at which omega_ was evaluated (NaN = none yet).
+        Species omega_C_;    ///< Concentrations at which omega_ was evaluated.
+        double  omega_p_;    ///< Rate multiplier omega_ was evaluated with.
+
+        /* ---------------- Jacobian scratch --------------------- */
+
+        std::vector<int>    kin_colptrs_;   ///< CSC column pointers of d(omega)/dC.
+        std::vector<int>    kin_rowvals_;   ///< CSC row indices of d(omega)/dC.
+        std::vector<double> dwdC_;          ///< d(omega_i)/d(C_j) on the kinetic pattern.
+        std::vector<int>    color_ptrs_;    ///< Start of each column group in color_cols_ (length = colors + 1).
+        std::vector<int>    color_cols_;    ///< Species columns of d(omega)/dC grouped by color.
+        bool                kin_verified_;  ///< Kinetic pattern checked by verifyKineticPattern().
+        int                 dwdC_age_;      ///< evalJacobianArrowhead() calls since dwdC_ was evaluated.
+        std::vector<int>    jac_colptrs_;   ///< CSC column pointers of the state Jacobian.
+        std::vector<int>    jac_rowvals_;   ///< CSC row indices of the state Jacobian.
+        std::vector<double> jcol_;          ///< One dense Jacobian column (length = setNEQ()).
+        Species dwdT_;                      ///< d(omega_i)/dT at fixed mass fractions.
+        Species dwdY_;                      ///< d(omega_i)/d(Y_j) for the column being assembled.
+        Species dcp_bardT_;                 ///< d(cp_bar_i)/dT.
+
+        double jacK_;        ///< P * MWtot / (Ru * T), so that C_i = jacK_ * Y_i / MW_i.
+        double jacdTdt_;     ///< dT/dt at the Jacobian state.
+        double jacS_;        ///< Sum of omega_.
+        double jacCsum_;     ///< Sum of C_.
+        double jacD_;        ///< Denominator of dT/dt.
+        double jacphi_;      ///< Dilatation term (S/Csum + dTdt/T) of dY/dt.
     
         /* ---------------- Miscellaneous ------------------------ */
     
@@ -182,16 +393,132 @@ class IdealGasConstPressureAdiabaticReactor
          * @details
          *   @todo Document basis conversions for cp_→cp_bar_ and h_→h_bar_.
          * @post cp_, h_, cp_bar_, h_bar_ consistent with @ref T_ and @ref MW_.
+         * @note Skipped when T_ equals @ref thermo_T_ exactly, as in difference-quotient
+         *       Jacobian columns that perturb a mass fraction.
          */
         void computeThermoProperties();
+
+        /**
+         * @brief Molar cp and h at @p T from @ref thermo_ or chemgen, never the table.
+         * @param[in] T Temperature [K].
+         * @param[out] cp_bar Molar cp (length n_species_).
+         * @param[out] h_bar Molar h (length n_species_).
+         */
+        void computeExactThermo(double T, double* cp_bar, double* h_bar) const;
+
+        /**
+         * @brief cp and h at @p T: table, then @ref thermo_, then chemgen.
+         * @param[in] T Temperature [K].
+         * @param[out] cp_bar, h_bar, cp, h Molar and mass-specific values (length n_species_).
+         */
+        void evaluateThermo(double T, double* cp_bar, double* h_bar, double* cp, double* h) const;
+
+        /**
+         * @brief Net production rates at (@p C, @p T), scaled by @ref rate_multiplier_.
+         */
+        void evaluateProductionRates(const Species& C, double T, Species& omega) const;
+
+        /**
+         * @brief Energy and species equations from evaluated properties.
+         * @param[out] ydot Derivative vector; layout [dT/dt, dY1/dt..dY_N/dt].
+         * @param[out] N Numerator of dT/dt.
+         * @param[out] D Denominator of dT/dt.
+         */
+        void assembleRHS(double T, double P, double MWtot, const Species& Y, const Species& cp_bar,
+                         const Species& h_bar, const Species& omega, double* ydot, double& N, double& D) const;
     
         /**
          * @brief Update chemical source terms for current state.
          * @details
          *   @todo Note any pressure-dependence through @ref C_ and libraries used by @ref source().
+         *   Skipped when T_, C_ and the rate multiplier equal those of the last call
+         *   exactly, as for a Jacobian at the state CVODES just evaluated the RHS at.
+         *   A temperature-only kinetics stage (k_f(T), K_c(T) kept across calls at one T)
+         *   is not possible from here: the generated source_species() evaluates every
+         *   call_forward_reaction_k() and gibbs_reaction() itself on each call, and chemgen
+         *   has no entry point taking precomputed rate constants. The stoichiometry that
+         *   would combine the per-reaction functions of reactions.h exists only inside it.
          * @post omega_ contains net production rates for each species.
          */
         void computeProductionRates();
+
+        /**
+         * @brief Update kinetic and thermo derivatives used by evalJacobian().
+         * @param[in] speciesColumns Evaluate d(omega)/dC; false keeps dwdC_ from the last call. (default: true)
+         * @details
+         *   d(omega)/dC is exact when chemgen provides source_jacobian(C, T) (detected
+         *   at compile time). Otherwise it is a compressed difference quotient: all
+         *   columns of one color (see computeSparsityPattern()) are perturbed together,
+         *   so it costs one source_species() call per color instead of one per species.
+         *   d(omega)/dT is a one-sided difference quotient in both cases (one
+         *   source_species() call): chemgen differentiates the individual rate
+         *   expressions in T (darrhenius_dtemperature() etc.) but exposes no d(omega)/dT.
+         * @pre computeThermoProperties() and computeProductionRates() called for current state.
+         * @post dwdT_, dcp_bardT_ (and dwdC_ if @p speciesColumns) consistent with @ref T_ and @ref C_.
+         */
+        void computeKineticJacobian(bool speciesColumns = true);
+
+        /**
+         * @brief Detect the structural pattern of d(omega)/dC and of the state Jacobian.
+         * @details
+         *   d(omega)/dC (from source_jacobian(), or by doubling each C_j in
+         *   source_species()) is evaluated at ChemConfig::SPARSITY_PROBES random
+         *   positive compositions and temperatures; the pattern is the union of the
+         *   nonzeros. chemgen generates the rate expressions as code, not as a
+         *   reaction table, so the structure cannot be read from the mechanism. The
+         *   first Jacobian checks the result (verifyKineticPattern()).
+         * @post kin_colptrs_/kin_rowvals_, jac_colptrs_/jac_rowvals_ and
+         *       color_ptrs_/color_cols_ populated.
+         */
+        void computeSparsityPattern();
+
+        /**
+         * @brief Store @p kin_rows as the CSC pattern of d(omega)/dC.
+         * @param[in,out] kin_rows Row indices per species column; sorted and deduplicated.
+         * @post kin_colptrs_/kin_rowvals_ set, dwdC_ zeroed, kin_verified_ false.
+         */
+        void setKineticPattern(std::vector<std::vector<int>>& kin_rows);
+
+        /**
+         * @brief Check the probed pattern and its coloring once, at the first real state.
+         * @details
+         *   Evaluates d(omega)/dC uncompressed (the full source_jacobian(), or one
+         *   source_species() call per species) and compares it with dwdC_. A nonzero
+         *   off the pattern is added to it and the columns are recolored; a mismatch
+         *   on the pattern without one disables the coloring (one species per color).
+         *   Either way dwdC_ takes the uncompressed values. Couplings added here reach
+         *   the state pattern only through the dense dilatation block, so without
+         *   ChemConfig::SPARSE_DILATATION the sparse Jacobian keeps its original pattern.
+         * @pre dwdC_ evaluated at the current state on the current pattern.
+         * @post kin_verified_ true.
+         */
+        void verifyKineticPattern();
+
+        /**
+         * @brief Color the columns of d(omega)/dC for the compressed difference quotient.
+         * @details
+         *   Greedy, largest column first (Curtis–Powell–Reid): two species share a color
+         *   only if no species' rate depends on both, so one perturbation recovers every
+         *   column of a color.
+         * @post color_ptrs_/color_cols_ populated from kin_colptrs_/kin_rowvals_.
+         */
+        void colorKineticPattern();
+
+        /**
+         * @brief Refresh state, properties, kinetic derivatives and shorthands at @p y.
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[in] ydot RHS at @p y.
+         * @param[in] speciesColumns Passed to computeKineticJacobian(). (default: true)
+         */
+        void prepareJacobian(double* y, double* ydot, bool speciesColumns = true);
+
+        /**
+         * @brief Compute one dense Jacobian column.
+         * @param[in] j Column index (0 = T, j >= 1 = Y_{j-1}).
+         * @param[out] col Column values (length = setNEQ()).
+         * @pre prepareJacobian() called for the current state.
+         */
+        void computeJacobianColumn(int j, double* col);
     
         /**
          * @brief Compute numerator N_ for dT/dt.
@@ -0,0 +1,431 @@
+/**
+ * @file NASA7Thermo.cpp
+ * @brief Coefficient recovery, validation and the fused cp/h kernel.
+ */
+
+#include "NASA7Thermo.h"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Chemgen header files */
+#include "types_inl.h"
+#include "multiply_divide.h"
+#include "pow_gen.h"
+#include "exp_gen.h"
+#include "array_handling.h"
+#include "constants.h"
+#include "thermally_perfect.h"
+
+
+namespace
+{
+    const double T_LOW_FIT[5]  = {300.0, 400.0, 500.0, 600.0, 700.0};           /* Below any usual midpoint */
+    const double T_HIGH_FIT[5] = {2000.0, 2250.0, 2500.0, 2750.0, 3000.0};      /* Above any usual midpoint */
+    const double T_SCALE       = 1000.0;                                        /* Fit in T/1000 to keep the Vandermonde system well scaled */
+    const double FIT_RTOL      = 1.0e-8;                                        /* Validation tolerance (relative) */
+    const int    N_BISECT      = 40;                                            /* 1300 K / 2^40 ~ 1e-9 K */
+
+
+    /* Solve the 5x5 system A x = b in place by Gaussian elimination with partial pivoting */
+    void solve5(double A[5][5], double b[5])
+    {
+        for(int k = 0; k < 5; k++)
+        {
+            int p = k;
+            for(int i = k + 1; i < 5; i++)
+            {
+                if(std::fabs(A[i][k]) > std::fabs(A[p][k]))
+                {
+                    p = i;
+                }
+            }
+            std::swap(A[k], A[p]);
+            std::swap(b[k], b[p]);
+
+            for(int i = k + 1; i < 5; i++)
+            {
+                double m = A[i][k] / A[k][k];
+                for(int j = k; j < 5; j++)
+                {
+                    A[i][j] -= m * A[k][j];
+                }
+                b[i] -= m * b[k];
+            }
+        }
+
+        for(int k = 4; k >= 0; k--)
+        {
+            for(int j = k + 1; j < 5; j++)
+            {
+                b[k] -= A[k][j] * b[j];
+            }
+            b[k] /= A[k][k];
+        }
+    }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#if defined(__AVX512F__)
+    typedef __m512d vdouble;
+    const int VLEN = 8;
+    inline vdouble vload(const double *p)                   { return _mm512_loadu_pd(p); }
+    inline void    vstore(double *p, vdouble a)             { _mm512_storeu_pd(p, a); }
+    inline vdouble vset(double a)                           { return _mm512_set1_pd(a); }
+    inline vdouble vmul(vdouble a, vdouble b)               { return _mm512_mul_pd(a, b); }
+    inline vdouble vmadd(vdouble a, vdouble b, vdouble c)   { return _mm512_fmadd_pd(a, b, c); }
+    typedef __mmask8 vmask;
+    inline vmask   vless(vdouble a, vdouble b)              { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    inline vdouble vselect(vmask m, vdouble a, vdouble b)   { return _mm512_mask_blend_pd(m, b, a); }   /* m ? a : b */
+#else
+    typedef __m256d vdouble;
+    const int VLEN = 4;
+    inline vdouble vload(const double *p)                   { return _mm256_loadu_pd(p); }
+    inline void    vstore(double *p, vdouble a)             { _mm256_storeu_pd(p, a); }
+    inline vdouble vset(double a)                           { return _mm256_set1_pd(a); }
+    inline vdouble vmul(vdouble a, vdouble b)               { return _mm256_mul_pd(a, b); }
+#if defined(__FMA__)
+    inline vdouble vmadd(vdouble a, vdouble b, vdouble c)   { return _mm256_fmadd_pd(a, b, c); }
+#else
+    inline vdouble vmadd(vdouble a, vdouble b, vdouble c)   { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+    typedef __m256d vmask;
+    inline vmask   vless(vdouble a, vdouble b)              { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    inline vdouble vselect(vmask m, vdouble a, vdouble b)   { return _mm256_blendv_pd(b, a, m); }       /* m ? a : b */
+#endif
+#endif
+}
+
+
+NASA7Thermo::NASA7Thermo()
+{
+    n_     = 0;
+    valid_ = false;
+    debug_ = 0;
+}
+
+
+NASA7Thermo::NASA7Thermo(int n, const double *MW, int debug)
+{
+    n_     = n;
+    valid_ = false;
+    debug_ = debug;
+
+    MW_.assign(MW, MW + n_);
+    invMW_.resize(n_);
+    for(int i = 0; i < n_; i++)
+    {
+        invMW_[i] = 1.0 / MW_[i];
+    }
+
+    fitRange(T_LOW_FIT, lo_);
+    fitRange(T_HIGH_FIT, hi_);
+    findMidpoints(T_LOW_FIT[4], T_HIGH_FIT[0]);
+    valid_ = validate();
+
+    if(debug_ == 1 || !valid_)
+    {
+        std::cout<<"--NASA-7 thermo kernel "<<(valid_ ? "enabled" : "disabled, chemgen thermo is not piecewise NASA-7")
+                 <<std::endl;
+    }
+}
+
+
+const NASA7Thermo& NASA7Thermo::chemgen(int n, const double *MW)
+{
+    static const NASA7Thermo shared(n, MW);
+
+    if(n != shared.n_)
+    {
+        throw std::invalid_argument("NASA7Thermo::chemgen(): species count differs from the shared kernel's");
+    }
+    return shared;
+}
+
+
+bool NASA7Thermo::isValid() const
+{
+    return valid_;
+}
+
+
+void NASA7Thermo::sample(double T, double *cp_bar, double *h_bar) const
+{
+    Species cp = species_specific_heat_constant_pressure_mass_specific(T);
+    Species h  = species_enthalpy_mass_specific(T);
+
+    for(int i = 0; i < n_; i++)
+    {
+        cp_bar[i] = cp[i] * MW_[i];
+        h_bar[i]  = h[i]  * MW_[i];
+    }
+}
+
+
+void NASA7Thermo::fitRange(const double *T, Range &r)
+{
+    std::vector<double> cp_s(5 * n_);
+    std::vector<double> h_s(5 * n_);
+    for(int m = 0; m < 5; m++)
+    {
+        sample(T[m], &cp_s[m * n_], &h_s[m * n_]);
+    }
+
+    for(int k = 0; k < 6; k++)
+    {
+        if(k < 5) r.cp[k].resize(n_);
+        if(k < 4) r.dcp[k].resize(n_);
+        r.h[k].resize(n_);
+    }
+
+    for(int i = 0; i < n_; i++)
+    {
+        /* cp_bar(T) = sum_k b_k (T/1000)^k through the five samples */
+        double A[5][5];
+        double b[5];
+        for(int m = 0; m < 5; m++)
+        {
+            double x = T[m] / T_SCALE;
+            A[m][0]  = 1.0;
+            for(int k = 1; k < 5; k++)
+            {
+                A[m][k] = A[m][k - 1] * x;
+            }
+            b[m] = cp_s[m * n_ + i];
+        }
+        solve5(A, b);
+
+        double scale = 1.0;
+        for(int k = 0; k < 5; k++)
+        {
+            r.cp[k][i] = b[k] / scale;                                          /* a_k = b_k / 1000^k */
+            r.h[k][i]  = r.cp[k][i] / (k + 1);
+            if(k > 0)
+            {
+                r.dcp[k - 1][i] = k * r.cp[k][i];
+            }
+            scale *= T_SCALE;
+        }
+
+        /* h_bar integration constant from the middle sample */
+        double Tm  = T[2];
+        double hp  = 0.0;
+        for(int k = 4; k >= 0; k--)
+        {
+            hp = (hp + r.h[k][i]) * Tm;
+        }
+        r.h[5][i] = h_s[2 * n_ + i] - hp;
+    }
+}
+
+
+void NASA7Thermo::findMidpoints(double Tlo, double Thi)
+{
+    std::vector<double> cp_ref(n_);
+    std::vector<double> h_ref(n_);
+
+    tmid_.assign(n_, Tlo);
+    for(int i = 0; i < n_; i++)
+    {
+        double a = Tlo;
+        double b = Thi;
+        for(int it = 0; it < N_BISECT; it++)
+        {
+            double T = 0.5 * (a + b);
+            sample(T, cp_ref.data(), h_ref.data());
+
+            double cp_lo = 0.0;
+            double cp_hi = 0.0;
+            for(int k = 4; k >= 0; k--)
+            {
+                cp_lo = cp_lo * T + lo_.cp[k][i];
+                cp_hi = cp_hi * T + hi_.cp[k][i];
+            }
+
+            if(std::fabs(cp_ref[i] - cp_lo) <= std::fabs(cp_ref[i] - cp_hi))
+            {
+                a = T;                                                          /* Still on the low branch */
+            }
+            else
+            {
+                b = T;
+            }
+        }
+        tmid_[i] = b;
+
+        /* Midpoints are round numbers in practice: snap, and find which branch chemgen
+         * uses at the midpoint itself so that "T < tmid_" reproduces its comparison */
+        double Ts = std::round(b);
+        if(std::fabs(b - Ts) < 1.0e-6)
+        {
+            sample(Ts, cp_ref.data(), h_ref.data());
+
+            double cp_lo = 0.0;
+            double cp_hi = 0.0;
+            for(int k = 4; k >= 0; k--)
+            {
+                cp_lo = cp_lo * Ts + lo_.cp[k][i];
+                cp_hi = cp_hi * Ts + hi_.cp[k][i];
+            }
+
+            bool low_at_mid = std::fabs(cp_ref[i] - cp_lo) < std::fabs(cp_ref[i] - cp_hi);
+            tmid_[i] = low_at_mid ? std::nextafter(Ts, 2.0 * Ts) : Ts;
+        }
+    }
+}
+
+
+bool NASA7Thermo::validate()
+{
+    std::vector<double> cp_ref(n_), h_ref(n_);
+    std::vector<double> cp_bar(n_), h_bar(n_), cp(n_), h(n_);
+
+    valid_ = true;                                                              /* evaluate() is used below */
+    for(double T = T_LOW_FIT[0]; T <= T_HIGH_FIT[4]; T += 25.0)
+    {
+        sample(T, cp_ref.data(), h_ref.data());
+        evaluate(T, cp_bar.data(), h_bar.data(), cp.data(), h.data());
+
+        for(int i = 0; i < n_; i++)
+        {
+            double cp_err = std::fabs(cp_bar[i] - cp_ref[i]);
+            double h_err  = std::fabs(h_bar[i] - h_ref[i]);
+            if(cp_err > FIT_RTOL * std::fabs(cp_ref[i]) + 1.0e-300
+               || h_err > FIT_RTOL * (std::fabs(h_ref[i]) + std::fabs(cp_ref[i]) * T))
+            {
+                if(debug_ == 1)
+                {
+                    std::cout<<"--NASA-7 fit of species "<<i<<" off by "<<cp_err<<" (cp), "
+                             <<h_err<<" (h) at T = "<<T<<std::endl;
+                }
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+inline void NASA7Thermo::evaluateSpecies(int i, double T, double *cp_bar, double *h_bar, double *cp, double *h) const
+{
+    const Range &r = (T < tmid_[i]) ? lo_ : hi_;
+
+    double c = r.cp[4][i];
+    double e = r.h[4][i];
+    for(int k = 3; k >= 0; k--)
+    {
+        c = c * T + r.cp[k][i];
+        e = e * T + r.h[k][i];
+    }
+    e = e * T + r.h[5][i];
+
+    cp_bar[i] = c;
+    h_bar[i]  = e;
+    cp[i]     = c * invMW_[i];
+    h[i]      = e * invMW_[i];
+}
+
+
+void NASA7Thermo::evaluate(double T, double *cp_bar, double *h_bar, double *cp, double *h) const
+{
+    int i = 0;
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+    /* One pass: per-lane range select, then Horner for cp and h sharing the broadcast T */
+    const vdouble vT = vset(T);
+    for(; i + VLEN <= n_; i += VLEN)
+    {
+        vmask lo = vless(vT, vload(&tmid_[i]));
+
+        vdouble c = vselect(lo, vload(&lo_.cp[4][i]), vload(&hi_.cp[4][i]));
+        vdouble e = vselect(lo, vload(&lo_.h[4][i]),  vload(&hi_.h[4][i]));
+        for(int k = 3; k >= 0; k--)
+        {
+            c = vmadd(c, vT, vselect(lo, vload(&lo_.cp[k][i]), vload(&hi_.cp[k][i])));
+            e = vmadd(e, vT, vselect(lo, vload(&lo_.h[k][i]),  vload(&hi_.h[k][i])));
+        }
+        e = vmadd(e, vT, vselect(lo, vload(&lo_.h[5][i]), vload(&hi_.h[5][i])));
+
+        vdouble invMW = vload(&invMW_[i]);
+        vstore(&cp_bar[i], c);
+        vstore(&h_bar[i], e);
+        vstore(&cp[i], vmul(c, invMW));
+        vstore(&h[i], vmul(e, invMW));
+    }
+#endif
+
+    for(; i < n_; i++)
+    {
+        evaluateSpecies(i, T, cp_bar, h_bar, cp, h);                            /* Scalar fallback / remainder */
+    }
+}
+
+
+void NASA7Thermo::evaluateLanes(int W, const double *T, double *cp_bar, double *h_bar) const
+{
+    for(int i = 0; i < n_; i++)
+    {
+        double *cp_i = &cp_bar[i * W];
+        double *h_i  = &h_bar[i * W];
+        int     l    = 0;
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+        /* Same Horner scheme as evaluate(), with the lanes running over cells */
+        const vdouble vtmid = vset(tmid_[i]);
+        for(; l + VLEN <= W; l += VLEN)
+        {
+            vdouble vT = vload(&T[l]);
+            vmask   lo = vless(vT, vtmid);
+
+            vdouble c = vselect(lo, vset(lo_.cp[4][i]), vset(hi_.cp[4][i]));
+            vdouble e = vselect(lo, vset(lo_.h[4][i]),  vset(hi_.h[4][i]));
+            for(int k = 3; k >= 0; k--)
+            {
+                c = vmadd(c, vT, vselect(lo, vset(lo_.cp[k][i]), vset(hi_.cp[k][i])));
+                e = vmadd(e, vT, vselect(lo, vset(lo_.h[k][i]),  vset(hi_.h[k][i])));
+            }
+            e = vmadd(e, vT, vselect(lo, vset(lo_.h[5][i]), vset(hi_.h[5][i])));
+
+            vstore(&cp_i[l], c);
+            vstore(&h_i[l], e);
+        }
+#endif
+
+        for(; l < W; l++)
+        {
+            const Range &r = (T[l] < tmid_[i]) ? lo_ : hi_;
+
+            double c = r.cp[4][i];
+            double e = r.h[4][i];
+            for(int k = 3; k >= 0; k--)
+            {
+                c = c * T[l] + r.cp[k][i];
+                e = e * T[l] + r.h[k][i];
+            }
+            cp_i[l] = c;
+            h_i[l]  = e * T[l] + r.h[5][i];
+        }
+    }
+}
+
+
+void NASA7Thermo::evaluateCpDerivative(double T, double *dcp_bardT) const
+{
+    for(int i = 0; i < n_; i++)
+    {
+        const Range &r = (T < tmid_[i]) ? lo_ : hi_;
+
+        double d = r.dcp[3][i];
+        for(int k = 2; k >= 0; k--)
+        {
+            d = d * T + r.dcp[k][i];
+        }
+        dcp_bardT[i] = d;
+    }
+}
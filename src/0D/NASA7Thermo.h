@@ -0,0 +1,148 @@
+/**
+ * @file NASA7Thermo.h
+ * @brief Fused, vectorized NASA 7-coefficient thermo kernel (cp, h, dcp/dT).
+ * @details
+ *   chemgen evaluates cp and h in two separate calls, each a full pass over its
+ *   coefficient tables. This kernel keeps the coefficients species-contiguous
+ *   (structure of arrays, one array per coefficient and temperature range) and
+ *   produces molar and mass-specific cp and h in one pass, with AVX-512 / AVX2
+ *   paths selected at compile time (use_native=1 in compile.sh, i.e. -march=native)
+ *   and a portable scalar fallback.
+ *
+ *   chemgen does not expose its coefficient tables, so they are recovered at
+ *   construction: cp_bar is a quartic in T on each side of a per-species
+ *   midpoint temperature, h_bar is its antiderivative plus a constant. Each
+ *   range is fitted through five chemgen samples, the midpoint is located by
+ *   bisection, and the result is checked against chemgen from 300 K to 3000 K.
+ *   If chemgen is not piecewise NASA-7 the check fails, isValid() is false and
+ *   the caller keeps using chemgen.
+ *
+ *   Entropy and Gibbs energies need the a6 integration constant, which cannot
+ *   be recovered from cp and h, so they are not provided.
+ */
+
+#ifndef SRC_REACTOR_NASA7_THERMO
+#define SRC_REACTOR_NASA7_THERMO
+
+#include <vector>
+
+
+/**
+ * @class NASA7Thermo
+ * @brief Species-contiguous NASA-7 coefficients and the fused cp/h kernel.
+ */
+class NASA7Thermo
+{
+    public:
+        /**
+         * @brief Empty, invalid kernel; assign a fitted one before use.
+         */
+        NASA7Thermo();
+
+        /**
+         * @brief Recover the coefficients of the first @p n chemgen species and validate them.
+         * @param[in] n Number of species.
+         * @param[in] MW Molecular weights, as used to convert chemgen's mass-specific values (length n).
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         */
+        NASA7Thermo(int n, const double *MW, int debug = 0);
+
+        /**
+         * @brief The kernel of the compiled-in chemgen mechanism, fitted once per process.
+         * @param[in] n Number of species (the chemgen species count).
+         * @param[in] MW chemgen molecular weights (length n); only read on the first call.
+         * @return Shared, read-only kernel (a function-local static, so thread-safe to build).
+         * @throws std::invalid_argument if @p n differs from the first call's.
+         * @note The fit costs ~40 n chemgen thermo evaluations; reactors share this
+         *       one instead of fitting their own.
+         */
+        static const NASA7Thermo& chemgen(int n, const double *MW);
+
+        /**
+         * @brief Whether the recovered coefficients reproduce chemgen.
+         * @return false if evaluate() must not be used.
+         */
+        bool isValid() const;
+
+        /**
+         * @brief cp and h of every species at @p T in one pass.
+         * @param[in] T Temperature [K].
+         * @param[out] cp_bar Molar cp (length n).
+         * @param[out] h_bar Molar h (length n).
+         * @param[out] cp Mass-specific cp (length n).
+         * @param[out] h Mass-specific h (length n).
+         * @note Units follow chemgen's mass-specific functions times its molecular weights.
+         */
+        void evaluate(double T, double *cp_bar, double *h_bar, double *cp, double *h) const;
+
+        /**
+         * @brief Molar cp and h of every species for @p W cells at once (structure of arrays).
+         * @param[in] W Number of cells (lanes).
+         * @param[in] T Temperatures of the cells [K] (length W).
+         * @param[out] cp_bar Molar cp, species i of cell l at [i*W + l].
+         * @param[out] h_bar Molar h, same layout.
+         * @details Vectorized across cells: each species' coefficients are broadcast and
+         *          every lane picks its own temperature range.
+         */
+        void evaluateLanes(int W, const double *T, double *cp_bar, double *h_bar) const;
+
+        /**
+         * @brief Analytic d(cp_bar)/dT of every species at @p T.
+         * @param[in] T Temperature [K].
+         * @param[out] dcp_bardT Derivative of molar cp (length n).
+         */
+        void evaluateCpDerivative(double T, double *dcp_bardT) const;
+
+
+    private:
+        /**
+         * @brief Coefficients of one temperature range, one array per power (SoA).
+         */
+        struct Range
+        {
+            std::vector<double> cp[5];                                          /*!< cp_bar = sum_k cp[k] T^k.                   */
+            std::vector<double> h[6];                                           /*!< h_bar  = h[5] + sum_k h[k] T^(k+1), h[k] = cp[k]/(k+1). */
+            std::vector<double> dcp[4];                                         /*!< dcp_bar/dT = sum_k dcp[k] T^k.              */
+        };
+
+        int    n_;                                                              /*!< Number of species.                          */
+        bool   valid_;                                                          /*!< Coefficients reproduce chemgen.             */
+        Range  lo_;                                                             /*!< T <  tmid_.                                 */
+        Range  hi_;                                                             /*!< T >= tmid_.                                 */
+        std::vector<double> tmid_;                                              /*!< Per-species midpoint temperature [K].       */
+        std::vector<double> MW_;                                                /*!< Molecular weights.                          */
+        std::vector<double> invMW_;                                             /*!< 1 / molecular weight.                       */
+
+        int debug_;
+
+        /**
+         * @brief Molar cp and h of every species from chemgen at @p T.
+         */
+        void sample(double T, double *cp_bar, double *h_bar) const;
+
+        /**
+         * @brief Fit the cp_bar quartic and h_bar constant of one range through chemgen samples.
+         * @param[in] T Five sample temperatures inside the range [K].
+         * @param[out] r Fitted range.
+         */
+        void fitRange(const double *T, Range &r);
+
+        /**
+         * @brief Locate each species' midpoint between the two fitted ranges by bisection.
+         */
+        void findMidpoints(double Tlo, double Thi);
+
+        /**
+         * @brief Compare evaluate() with chemgen over the validation grid.
+         * @return true if all species agree to rounding.
+         */
+        bool validate();
+
+        /**
+         * @brief Scalar kernel for species @p i (fallback and SIMD remainder).
+         */
+        void evaluateSpecies(int i, double T, double *cp_bar, double *h_bar, double *cp, double *h) const;
+};
+
+
+#endif /* SRC_REACTOR_NASA7_THERMO */
@@ -0,0 +1,301 @@
+/**
+ * @file Reactor.cpp
+ * @brief Compile-time sized reactor: definitions and the chemgen instantiation.
+ */
+
+#include <type_traits>
+
+#include "Reactor.h"
+#include "ChemConfig.h"
+#include "Dual.h"
+
+#include "multiply_divide.h"
+#include "pow_gen.h"
+#include "exp_gen.h"
+#include "array_handling.h"
+#include "constants.h"
+#include "thermally_perfect.h"
+#include "arrhenius.h"
+#include "third_body.h"
+#include "falloff_troe.h"
+#include "falloff_lindemann.h"
+#include "falloff_sri.h"
+#include "pressure_dependent_arrhenius.h"
+#include "reactions.h"
+#include "source.h"
+#include "chemical_state_functions.h"
+
+#include "ChemgenJacobian.h"                                                    /* After chemgen: shared d(omega)/dC, d(omega)/dT, d(cp)/dT */
+
+
+template<int NSpecies>
+const typename Reactor<NSpecies>::SpeciesArray& Reactor<NSpecies>::MW()
+{
+    static const SpeciesArray mw = []
+    {
+        Species      s = molecular_weights();
+        SpeciesArray a;
+        for(int i = 0; i < NSpecies; i++)
+        {
+            a[i] = s[i];
+        }
+        return a;
+    }();
+
+    return mw;
+}
+
+
+template<int NSpecies>
+const typename Reactor<NSpecies>::SpeciesArray& Reactor<NSpecies>::invMW()
+{
+    static const SpeciesArray inv = []
+    {
+        SpeciesArray a;
+        for(int i = 0; i < NSpecies; i++)
+        {
+            a[i] = 1.0 / MW()[i];
+        }
+        return a;
+    }();
+
+    return inv;
+}
+
+
+template<int NSpecies>
+Reactor<NSpecies>::Reactor(double temperature, double pressure)
+{
+    T_        = temperature;
+    P_        = pressure;
+    thermo_T_ = std::numeric_limits<double>::quiet_NaN();
+    kin_T_    = std::numeric_limits<double>::quiet_NaN();
+    thermo_   = &NASA7Thermo::chemgen(NSpecies, MW().data());                   /* Falls back to chemgen thermo if invalid */
+
+    double y[NEQ];
+    y[0] = T_;
+    for(int i = 1; i < NEQ; i++)
+    {
+        y[i] = 1.0 / NSpecies;
+    }
+    setMixtureMolecularWeight(&y[1]);
+    setState(y);
+}
+
+
+template<int NSpecies>
+void Reactor<NSpecies>::setInitialState(double* y)
+{
+    y[0] = T_;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        y[i + 1] = Y_[i];
+    }
+}
+
+
+template<int NSpecies>
+void Reactor<NSpecies>::setCellState(double temperature, double pressure, const double* Y)
+{
+    double y[NEQ];
+
+    P_   = pressure;
+    y[0] = temperature;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        y[i + 1] = Y[i];
+    }
+    setMixtureMolecularWeight(Y);
+    setState(y);
+}
+
+
+template<int NSpecies>
+template<typename S>
+void Reactor<NSpecies>::evalRHS(double t, const S* y, S* ydot)
+{
+    setState(y);
+    computeThermoProperties();
+    omega_ = source_species(C_, T_);
+
+    if constexpr (std::is_same_v<S, double>)
+    {
+        assemble(T_, K_, &Y_[0], &C_[0], &cp_bar_[0], &h_bar_[0], &omega_[0], ydot);
+    }
+    else
+    {
+        /* Lift the double-only thermo and kinetics onto the lanes of y: every
+         * quantity carries its value from above and the chain rule through T and C */
+        const SpeciesArray &invMW = Reactor::invMW();
+
+        computeKineticJacobian();
+
+        const S &T = y[0];
+        S        K = P_ * MWtot_ / (ChemConfig::Ru * T);
+
+        std::array<S, NSpecies> C, cp_bar, h_bar, omega;
+        for(int i = 0; i < NSpecies; i++)
+        {
+            C[i]      = K * y[i + 1] * invMW[i];
+            cp_bar[i] = chain(T, cp_bar_[i], dcp_bardT_[i]);
+            h_bar[i]  = chain(T, h_bar_[i],  cp_bar_[i]);
+            omega[i]  = chain(T, omega_[i],  dwdT_[i]);
+        }
+        for(int j = 0; j < NSpecies; j++)
+        {
+            for(int i = 0; i < NSpecies; i++)
+            {
+                for(int q = 0; q < static_cast<int>(std::size(C[j].d)); q++)
+                {
+                    omega[i].d[q] += dwdC_[j * NSpecies + i] * C[j].d[q];
+                }
+            }
+        }
+
+        assemble(T, K, y + 1, C.data(), cp_bar.data(), h_bar.data(), omega.data(), ydot);
+    }
+}
+
+
+template<int NSpecies>
+template<typename S>
+void Reactor<NSpecies>::assemble(const S& T, const S& K, const S* Y, const S* C, const S* cp_bar, const S* h_bar,
+                                 const S* omega, S* ydot) const
+{
+    const SpeciesArray &MW = Reactor::MW();
+
+    /* ---------------- Energy equation ---------------- */
+    S N = 0.0;
+    S D = 0.0;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        N -= h_bar[i] * omega[i];
+        D += C[i] * cp_bar[i];
+    }
+    S dTdt  = N / D;
+    ydot[0] = dTdt;
+
+    /* ---------------- Species equations ---------------- */
+    S omega_sum         = 0.0;
+    S concentration_sum = 0.0;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        omega_sum         += omega[i];
+        concentration_sum += C[i];
+    }
+
+    S phi  = omega_sum / concentration_sum + dTdt / T;
+    S invK = 1.0 / K;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        ydot[i + 1] = omega[i] * MW[i] * invK - Y[i] * phi;
+    }
+}
+
+
+template<int NSpecies>
+double Reactor<NSpecies>::getTemperature()
+{
+    return T_;
+}
+
+
+template<int NSpecies>
+double Reactor<NSpecies>::getPressure()
+{
+    return P_;
+}
+
+
+template<int NSpecies>
+template<typename S>
+void Reactor<NSpecies>::setState(const S* y)
+{
+    const SpeciesArray &invMW = Reactor::invMW();
+
+    T_ = value(y[0]);
+    K_ = P_ * MWtot_ / (ChemConfig::Ru * T_);
+    for(int i = 0; i < NSpecies; i++)
+    {
+        Y_[i] = value(y[i + 1]);
+        C_[i] = K_ * Y_[i] * invMW[i];
+    }
+}
+
+
+template<int NSpecies>
+void Reactor<NSpecies>::setMixtureMolecularWeight(const double* Y)
+{
+    const SpeciesArray &invMW = Reactor::invMW();
+
+    double sum = 0.0;
+    for(int i = 0; i < NSpecies; i++)
+    {
+        sum += Y[i] * invMW[i];
+    }
+    MWtot_ = 1.0 / sum;
+}
+
+
+template<int NSpecies>
+void Reactor<NSpecies>::computeThermoProperties()
+{
+    if(T_ == thermo_T_)
+    {
+        return;
+    }
+    thermo_T_ = T_;
+
+    if(thermo_->isValid())
+    {
+        thermo_->evaluate(T_, &cp_bar_[0], &h_bar_[0], &cp_[0], &h_[0]);
+        return;
+    }
+
+    const SpeciesArray &MW = Reactor::MW();
+
+    cp_ = species_specific_heat_constant_pressure_mass_specific(T_);
+    h_  = species_enthalpy_mass_specific(T_);
+    for(int i = 0; i < NSpecies; i++)
+    {
+        cp_bar_[i] = cp_[i] * MW[i];
+        h_bar_[i]  = h_[i]  * MW[i];
+    }
+}
+
+
+template<int NSpecies>
+void Reactor<NSpecies>::computeKineticJacobian()
+{
+    bool same = (T_ == kin_T_);
+    for(int i = 0; same && i < NSpecies; i++)
+    {
+        same = (C_[i] == kin_C_[i]);
+    }
+    if(same)
+    {
+        return;
+    }
+    kin_T_ = T_;
+    kin_C_ = C_;
+
+    /* d(omega)/dC at fixed T (dense: no pattern is kept here), d(omega)/dT at fixed C
+     * (the lanes of C carry the 1/T of the concentrations) */
+    ChemgenJacobian::denseSourceJacobian(C_, T_, omega_, 1.0, NSpecies, dwdC_.data());
+    ChemgenJacobian::sourceTemperatureDerivative(C_, T_, omega_, 1.0, NSpecies, false, dwdT_.data());
+
+    if(thermo_->isValid())
+    {
+        thermo_->evaluateCpDerivative(T_, &dcp_bardT_[0]);                      /* Exact, no extra thermo pass */
+    }
+    else
+    {
+        ChemgenJacobian::specificHeatTemperatureDerivative(T_, MW().data(), NSpecies, dcp_bardT_.data());
+    }
+}
+
+
+template class Reactor<CHEMGEN_NSPECIES>;
+template void Reactor<CHEMGEN_NSPECIES>::evalRHS<double>(double, const double*, double*);
+template void Reactor<CHEMGEN_NSPECIES>::evalRHS<Dual<ChemConfig::AD_LANES>>(double, const Dual<ChemConfig::AD_LANES>*,
+                                                                             Dual<ChemConfig::AD_LANES>*);
@@ -0,0 +1,178 @@
+/**
+ * @file Reactor.h
+ * @brief Constant-pressure, adiabatic ideal-gas reactor with a compile-time species count.
+ * @details
+ *   Same model and state layout [T, Y1..Y_N] as IdealGasConstPressureAdiabaticReactor,
+ *   including its closure: the mixture molecular weight is computed from the
+ *   composition at setCellState() (or construction) and held fixed while the
+ *   cell is integrated, so concentrations follow C_i = P MWtot Y_i / (Ru T MW_i)
+ *   with that MWtot. The two classes give the same RHS for the same cell, but
+ *   every array has a compile-time size and every species loop a compile-time
+ *   trip count, so the RHS can be fully unrolled and vectorized for small mechanisms.
+ *   NSpecies must match the chemgen Species type; a mismatch is a compile error
+ *   instead of a silently wrong runtime @p n.
+ *
+ *   The chemgen headers are only included in Reactor.cpp, which explicitly
+ *   instantiates Reactor<CHEMGEN_NSPECIES> (the only size that passes the check).
+ *
+ *   The RHS is templated on the scalar type, so ADJacobianAdapter can run it with
+ *   Dual<ChemConfig::AD_LANES> (see @ref ADModel): the thermo (with an exact
+ *   dcp/dT), the concentrations and the energy/species assembly are differentiated
+ *   exactly, and chemgen's double-only source_species() enters through d(omega)/dC
+ *   and d(omega)/dT at the current state (ChemgenJacobian.h: d(omega)/dC from
+ *   source_jacobian() when the mechanism has it, otherwise difference quotients;
+ *   d(omega)/dT always a difference quotient). Through ReactorAdapter the
+ *   integrator instead builds the Jacobian by difference quotients. Use
+ *   IdealGasConstPressureAdiabaticReactor for the sparse Jacobians and
+ *   sensitivities.
+ */
+
+#ifndef SRC_REACTOR_REACTOR
+#define SRC_REACTOR_REACTOR
+
+#include <array>
+#include <limits>
+
+/* Chemgen header files */
+#include "types_inl.h"  /* For Species */
+
+#include "NASA7Thermo.h"
+
+
+/**
+ * @brief Number of species of the compiled-in chemgen mechanism.
+ */
+inline constexpr int CHEMGEN_NSPECIES = static_cast<int>(sizeof(Species) / sizeof(double));
+
+
+/**
+ * @class Reactor
+ * @brief Constant-pressure, adiabatic reactor for an ideal-gas mixture of @p NSpecies species.
+ * @tparam NSpecies Number of species; must equal CHEMGEN_NSPECIES.
+ */
+template<int NSpecies>
+class Reactor
+{
+    static_assert(NSpecies == CHEMGEN_NSPECIES, "Reactor<NSpecies>: NSpecies does not match the chemgen mechanism");
+
+    public:
+        static constexpr int NEQ = NSpecies + 1;                                /*!< State size, [T, Y1..Y_N]. */
+
+        using SpeciesArray = std::array<double, NSpecies>;
+
+        /**
+         * @brief Construct the reactor at a uniform composition.
+         * @param[in] temperature Initial temperature [K]. (default: 300)
+         * @param[in] pressure Pressure [Pa]. (default: 101325.0)
+         */
+        explicit Reactor(double temperature = 300, double pressure = 101325.0);
+
+        /**
+         * @brief Number of ODE equations.
+         * @return NEQ.
+         */
+        static constexpr int setNEQ() { return NEQ; }
+
+        /**
+         * @brief Populate an external state vector with the current state.
+         * @param[out] y State array of length NEQ; layout [T, Y1..Y_N].
+         */
+        void setInitialState(double* y);
+
+        /**
+         * @brief Reset the reactor to a new cell state.
+         * @param[in] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa].
+         * @param[in] Y Mass fractions (length NSpecies).
+         */
+        void setCellState(double temperature, double pressure, const double* Y);
+
+        /**
+         * @brief Evaluate the ODE right-hand side: dT/dt and dY/dt.
+         * @tparam S double, or Dual<ChemConfig::AD_LANES> for derivative lanes (the
+         *           two instantiations in Reactor.cpp).
+         * @param[in] t Unused (autonomous system).
+         * @param[in] y State vector; layout [T, Y1..Y_N].
+         * @param[out] ydot Derivative vector; layout [dT/dt, dY1/dt..dY_N/dt].
+         */
+        template<typename S>
+        void evalRHS(double t, const S* y, S* ydot);
+
+        /* Debugger, getter fns */
+        double getTemperature();
+        double getPressure();
+        static constexpr int getNumberofSpecies() { return NSpecies; }
+
+
+    private:
+        double  T_;                                                             /*!< Temperature [K].                 */
+        double  P_;                                                             /*!< Pressure [Pa].                   */
+        double  MWtot_;                                                         /*!< Mixture molecular weight, frozen at setCellState(). */
+        double  K_;                                                             /*!< P * MWtot / (Ru * T): C_i = K_ * Y_i / MW_i. */
+
+        Species Y_;                                                             /*!< Mass fractions.                  */
+        Species C_;                                                             /*!< Concentrations.                  */
+        Species cp_;                                                            /*!< Mass-specific cp.                */
+        Species h_;                                                             /*!< Mass-specific h.                 */
+        Species cp_bar_;                                                        /*!< Molar cp.                        */
+        Species h_bar_;                                                         /*!< Molar h.                         */
+        Species omega_;                                                         /*!< Net production rates.            */
+
+        const NASA7Thermo *thermo_;                                             /*!< Shared cp/h kernel; chemgen thermo when invalid. */
+        double      thermo_T_;                                                  /*!< T of cp_, h_, cp_bar_, h_bar_ (NaN = none yet). */
+
+        std::array<double, NSpecies * NSpecies> dwdC_;                          /*!< d(omega_i)/d(C_j) at [j*N + i] (AD path only). */
+        SpeciesArray dwdT_;                                                     /*!< d(omega)/dT at fixed C.          */
+        SpeciesArray dcp_bardT_;                                                /*!< d(cp_bar)/dT.                    */
+        double       kin_T_;                                                    /*!< T of dwdC_, dwdT_ (NaN = none yet). */
+        Species      kin_C_;                                                    /*!< C of dwdC_, dwdT_.               */
+
+        /**
+         * @brief Molecular weights from chemgen, copied once on first use.
+         * @note Function-local statics, so reactors built during static initialization are safe.
+         */
+        static const SpeciesArray& MW();
+
+        /**
+         * @brief 1 / molecular weight, built once on first use.
+         */
+        static const SpeciesArray& invMW();
+
+        /**
+         * @brief Load T and Y from the values of @p y and refresh K_ and C_ (MWtot_ unchanged).
+         */
+        template<typename S>
+        void setState(const S* y);
+
+        /**
+         * @brief Freeze MWtot_ at the mixture molecular weight of @p Y.
+         * @param[in] Y Mass fractions (length NSpecies).
+         */
+        void setMixtureMolecularWeight(const double* Y);
+
+        /**
+         * @brief Update cp_, h_, cp_bar_, h_bar_ at T_; skipped when T_ equals thermo_T_.
+         */
+        void computeThermoProperties();
+
+        /**
+         * @brief Update dwdC_, dwdT_ and dcp_bardT_ at T_, C_; skipped when both are unchanged.
+         * @details The AD passes of one Jacobian share the state, so the N + 1
+         *          source_species() calls (or one source_jacobian()) are paid once per Jacobian.
+         */
+        void computeKineticJacobian();
+
+        /**
+         * @brief Energy and species equations from the thermo and the production rates.
+         * @tparam S Scalar type of every argument (see evalRHS()).
+         */
+        template<typename S>
+        void assemble(const S& T, const S& K, const S* Y, const S* C, const S* cp_bar, const S* h_bar,
+                      const S* omega, S* ydot) const;
+};
+
+
+extern template class Reactor<CHEMGEN_NSPECIES>;
+
+
+#endif /* SRC_REACTOR_REACTOR */
@@ -0,0 +1,188 @@
+/**
+ * @file ReactorBatch.cpp
+ * @brief W-lane RHS kernel and its instantiations for 4 and 8 lanes.
+ */
+
+#include "ReactorBatch.h"
+#include "ChemConfig.h"
+
+#include "multiply_divide.h"
+#include "pow_gen.h"
+#include "exp_gen.h"
+#include "array_handling.h"
+#include "constants.h"
+#include "thermally_perfect.h"
+#include "arrhenius.h"
+#include "third_body.h"
+#include "falloff_troe.h"
+#include "falloff_lindemann.h"
+#include "falloff_sri.h"
+#include "pressure_dependent_arrhenius.h"
+#include "reactions.h"
+#include "source.h"
+#include "chemical_state_functions.h"
+
+
+template<int W>
+ReactorBatch<W>::ReactorBatch()
+{
+    Species mw = molecular_weights();
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        MW_[i]    = mw[i];
+        invMW_[i] = 1.0 / mw[i];
+    }
+    thermo_ = &NASA7Thermo::chemgen(NSPECIES, MW_.data());                      /* Falls back to chemgen thermo if invalid */
+    thermo_T_.fill(std::numeric_limits<double>::quiet_NaN());
+
+    double Y[NSPECIES];
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        Y[i] = 1.0 / NSPECIES;
+    }
+    for(int l = 0; l < W; l++)
+    {
+        setCellState(l, 300.0, 101325.0, Y);
+    }
+}
+
+
+template<int W>
+void ReactorBatch<W>::setCellState(int lane, double temperature, double pressure, const double* Y)
+{
+    double sum = 0.0;
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        sum += Y[i] * invMW_[i];
+        y0_[(i + 1) * W + lane] = Y[i];
+    }
+
+    y0_[lane]     = temperature;
+    P_[lane]      = pressure;
+    MWtot_[lane]  = 1.0 / sum;
+}
+
+
+template<int W>
+void ReactorBatch<W>::setInitialState(double* y) const
+{
+    for(int k = 0; k < NEQ * W; k++)
+    {
+        y[k] = y0_[k];
+    }
+}
+
+
+template<int W>
+void ReactorBatch<W>::evalRHS(const double* y, double* ydot)
+{
+    const double *T    = &y[0];
+    const double *Y    = &y[W];
+    double       *dTdt = &ydot[0];
+    double       *dYdt = &ydot[W];
+
+    /* C_i = K * Y_i / MW_i, K = P * MWtot / (Ru * T) */
+    LaneArray K;
+    for(int l = 0; l < W; l++)
+    {
+        K[l] = (P_[l] * MWtot_[l]) / (ChemConfig::Ru * T[l]);
+    }
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        for(int l = 0; l < W; l++)
+        {
+            C_[i * W + l] = K[l] * Y[i * W + l] * invMW_[i];
+        }
+    }
+
+    computeThermoProperties(T);
+    computeProductionRates(T);
+
+    /* ---------------- Energy equation ---------------- */
+    LaneArray N{}, D{}, S{}, Csum{};
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        for(int l = 0; l < W; l++)
+        {
+            N[l]    -= h_bar_[i * W + l] * omega_[i * W + l];
+            D[l]    += C_[i * W + l] * cp_bar_[i * W + l];
+            S[l]    += omega_[i * W + l];
+            Csum[l] += C_[i * W + l];
+        }
+    }
+
+    LaneArray phi, invK;
+    for(int l = 0; l < W; l++)
+    {
+        dTdt[l] = N[l] / D[l];
+        phi[l]  = S[l] / Csum[l] + dTdt[l] / T[l];
+        invK[l] = 1.0 / K[l];
+    }
+
+    /* ---------------- Species equations ---------------- */
+    for(int i = 0; i < NSPECIES; i++)
+    {
+        for(int l = 0; l < W; l++)
+        {
+            dYdt[i * W + l] = omega_[i * W + l] * MW_[i] * invK[l] - Y[i * W + l] * phi[l];
+        }
+    }
+}
+
+
+template<int W>
+void ReactorBatch<W>::computeThermoProperties(const double* T)
+{
+    bool same = true;
+    for(int l = 0; l < W; l++)
+    {
+        same = same && (T[l] == thermo_T_[l]);
+        thermo_T_[l] = T[l];
+    }
+    if(same)
+    {
+        return;                                                                 /* Mass-fraction DQ columns */
+    }
+
+    if(thermo_->isValid())
+    {
+        thermo_->evaluateLanes(W, T, cp_bar_.data(), h_bar_.data());
+        return;
+    }
+
+    for(int l = 0; l < W; l++)
+    {
+        Species cp = species_specific_heat_constant_pressure_mass_specific(T[l]);
+        Species h  = species_enthalpy_mass_specific(T[l]);
+        for(int i = 0; i < NSPECIES; i++)
+        {
+            cp_bar_[i * W + l] = cp[i] * MW_[i];
+            h_bar_[i * W + l]  = h[i]  * MW_[i];
+        }
+    }
+}
+
+
+template<int W>
+void ReactorBatch<W>::computeProductionRates(const double* T)
+{
+    Species C;
+
+    for(int l = 0; l < W; l++)
+    {
+        for(int i = 0; i < NSPECIES; i++)
+        {
+            C[i] = C_[i * W + l];                                               /* Gather lane l */
+        }
+
+        Species omega = source_species(C, T[l]);
+        for(int i = 0; i < NSPECIES; i++)
+        {
+            omega_[i * W + l] = omega[i];                                       /* Scatter back */
+        }
+    }
+}
+
+
+template class ReactorBatch<4>;
+template class ReactorBatch<8>;
@@ -0,0 +1,110 @@
+/**
+ * @file ReactorBatch.h
+ * @brief Constant-pressure RHS of W cells at once, vectorized across cells.
+ * @details
+ *   Vectorizing one cell's RHS across species is limited by the irregular
+ *   stoichiometry; across cells every operation is identical. The batch keeps
+ *   the W cells in a structure-of-arrays layout,
+ *
+ *       y[0*W + l]     = T of cell l,
+ *       y[(i+1)*W + l] = Y_i of cell l,
+ *
+ *   so that every species loop of the RHS (concentrations, thermo, energy and
+ *   species equations) runs over W contiguous lanes. Thermo uses
+ *   NASA7Thermo::evaluateLanes(). Production rates stay per cell: chemgen's
+ *   source_species() is a scalar call, so each lane is gathered, evaluated
+ *   and scattered back.
+ *
+ *   The model is that of IdealGasConstPressureAdiabaticReactor (mixture
+ *   molecular weight fixed at setCellState()); pressure is per cell.
+ *   ReactorBatchAdapter<W> exposes a batch as one Utility model of W*NEQ
+ *   equations for the integrators.
+ */
+
+#ifndef SRC_REACTOR_REACTOR_BATCH
+#define SRC_REACTOR_REACTOR_BATCH
+
+#include <array>
+#include <limits>
+
+#include "Reactor.h"                                                            /* CHEMGEN_NSPECIES */
+#include "NASA7Thermo.h"
+
+
+/**
+ * @class ReactorBatch
+ * @brief W-lane, structure-of-arrays RHS kernel.
+ * @tparam W Number of cells (lanes); typically the SIMD width in doubles (4 or 8).
+ */
+template<int W>
+class ReactorBatch
+{
+    public:
+        static constexpr int NSPECIES = CHEMGEN_NSPECIES;                       /*!< Species per cell.          */
+        static constexpr int NEQ      = NSPECIES + 1;                           /*!< Equations per cell.        */
+        static constexpr int LANES    = W;                                      /*!< Cells per batch.           */
+
+        /**
+         * @brief Construct a batch with every lane at 300 K, 101325 Pa and a uniform composition.
+         */
+        ReactorBatch();
+
+        /**
+         * @brief Load a cell into one lane.
+         * @param[in] lane Lane index, 0 <= lane < W.
+         * @param[in] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa].
+         * @param[in] Y Mass fractions (length NSPECIES).
+         */
+        void setCellState(int lane, double temperature, double pressure, const double* Y);
+
+        /**
+         * @brief Write the lanes' loaded states in the batch layout.
+         * @param[out] y Batch state (length W*NEQ).
+         */
+        void setInitialState(double* y) const;
+
+        /**
+         * @brief Evaluate the RHS of all W cells.
+         * @param[in] y Batch state (length W*NEQ), layout above.
+         * @param[out] ydot Batch RHS, same layout.
+         */
+        void evalRHS(const double* y, double* ydot);
+
+
+    private:
+        using LaneArray    = std::array<double, W>;
+        using SpeciesLanes = std::array<double, NSPECIES * W>;
+
+        std::array<double, NSPECIES> MW_;                                       /*!< Molecular weights.                 */
+        std::array<double, NSPECIES> invMW_;                                    /*!< 1 / molecular weight.              */
+        const NASA7Thermo *thermo_;                                             /*!< Shared lane kernel; chemgen when invalid. */
+
+        LaneArray    P_;                                                        /*!< Pressure per cell [Pa].            */
+        LaneArray    MWtot_;                                                    /*!< Mixture MW per cell.               */
+        std::array<double, NEQ * W> y0_;                                        /*!< Loaded states, batch layout.       */
+        LaneArray    thermo_T_;                                                 /*!< Lane T of cp_bar_, h_bar_ (NaN = none yet). */
+
+        /* Scratch, species i of cell l at [i*W + l] */
+        alignas(64) SpeciesLanes C_;
+        alignas(64) SpeciesLanes cp_bar_;
+        alignas(64) SpeciesLanes h_bar_;
+        alignas(64) SpeciesLanes omega_;
+
+        /**
+         * @brief cp_bar_, h_bar_ for the lane temperatures @p T; skipped if no lane's T changed.
+         */
+        void computeThermoProperties(const double* T);
+
+        /**
+         * @brief omega_ from C_ and @p T, one chemgen call per lane.
+         */
+        void computeProductionRates(const double* T);
+};
+
+
+extern template class ReactorBatch<4>;
+extern template class ReactorBatch<8>;
+
+
+#endif /* SRC_REACTOR_REACTOR_BATCH */
@@ -0,0 +1,276 @@
+/**
+ * @file ThermoTable.cpp
+ * @brief Table construction, error check and interpolation.
+ */
+
+#include "ThermoTable.h"
+#include "ChemConfig.h"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+
+ThermoTable::ThermoTable()
+{
+    n_         = 0;
+    mode_      = ThermoMode::Exact;
+    nnodes_    = 0;
+    Tmin_      = 0.0;
+    dT_        = 0.0;
+    invdT_     = 0.0;
+    maxerr_    = 0.0;
+    nfallback_ = 0;
+    debug_     = 0;
+}
+
+
+ThermoTable::ThermoTable(int n, const double *MW, ThermoMode mode, double rtol, const ExactThermo &exact, int debug)
+    : ThermoTable()
+{
+    n_     = n;
+    mode_  = mode;
+    debug_ = debug;
+
+    invMW_.resize(n_);
+    for(int i = 0; i < n_; i++)
+    {
+        invMW_[i] = 1.0 / MW[i];
+    }
+
+    double range = ChemConfig::THERMO_TABLE_TMAX - ChemConfig::THERMO_TABLE_TMIN;
+    double dT    = ChemConfig::THERMO_TABLE_DT;
+
+    /* Halve the spacing until only kink intervals exceed rtol, or memory runs out */
+    while(true)
+    {
+        build(dT, exact);
+        double flagged = check(rtol, exact);
+
+        bool   fits_memory = (2.0 * range / dT + 1.0) * n_ <= ChemConfig::THERMO_TABLE_MAX_ENTRIES;
+        if(flagged <= ChemConfig::THERMO_TABLE_MAX_FALLBACK || !fits_memory)
+        {
+            break;
+        }
+        dT *= 0.5;
+    }
+
+    if(debug_ == 1 || nfallback_ > 0.1 * (nnodes_ - 1))
+    {
+        std::cout<<"--Thermo table: dT = "<<dT_<<" K, "<<nnodes_<<" nodes, max error "<<maxerr_
+                 <<", "<<nfallback_<<" intervals on the exact path"<<std::endl;
+    }
+}
+
+
+void ThermoTable::build(double dT, const ExactThermo &exact)
+{
+    double range = ChemConfig::THERMO_TABLE_TMAX - ChemConfig::THERMO_TABLE_TMIN;
+
+    Tmin_   = ChemConfig::THERMO_TABLE_TMIN;
+    nnodes_ = static_cast<int>(std::ceil(range / dT)) + 1;
+    dT_     = range / (nnodes_ - 1);
+    invdT_  = 1.0 / dT_;
+
+    cp_.assign(nnodes_ * n_, 0.0);
+    h_.assign(nnodes_ * n_, 0.0);
+    exact_.assign(nnodes_ - 1, 0);
+
+    for(int j = 0; j < nnodes_; j++)
+    {
+        exact(Tmin_ + j * dT_, &cp_[j * n_], &h_[j * n_]);
+    }
+
+    if(mode_ != ThermoMode::TableCubic)
+    {
+        dcp_.clear();
+        return;
+    }
+
+    /* Node slopes of cp by central differences of the exact path */
+    std::vector<double> cp_p(n_), cp_m(n_), h_tmp(n_);
+    double delta = 1.0e-3 * dT_;
+
+    dcp_.assign(nnodes_ * n_, 0.0);
+    for(int j = 0; j < nnodes_; j++)
+    {
+        double T = Tmin_ + j * dT_;
+        exact(T + delta, cp_p.data(), h_tmp.data());
+        exact(T - delta, cp_m.data(), h_tmp.data());
+        for(int i = 0; i < n_; i++)
+        {
+            dcp_[j * n_ + i] = (cp_p[i] - cp_m[i]) / (2.0 * delta);
+        }
+    }
+}
+
+
+double ThermoTable::check(double rtol, const ExactThermo &exact)
+{
+    std::vector<double> cp_ref(n_), h_ref(n_), cp_tab(n_), h_tab(n_);
+    const double tq[3] = {0.25, 0.5, 0.75};
+
+    maxerr_    = 0.0;
+    nfallback_ = 0;
+    for(int j = 0; j < nnodes_ - 1; j++)
+    {
+        double err = 0.0;
+        for(double t : tq)
+        {
+            double T = Tmin_ + (j + t) * dT_;
+            exact(T, cp_ref.data(), h_ref.data());
+            interpolate(j, t, cp_tab.data(), h_tab.data());
+
+            for(int i = 0; i < n_; i++)
+            {
+                double cp_scale = std::fabs(cp_ref[i]);
+                double h_scale  = std::fabs(h_ref[i]) + cp_scale * T;
+                err = std::max(err, std::fabs(cp_tab[i] - cp_ref[i]) / cp_scale);
+                err = std::max(err, std::fabs(h_tab[i] - h_ref[i]) / h_scale);
+            }
+        }
+
+        if(err > rtol)
+        {
+            exact_[j] = 1;
+            nfallback_++;
+        }
+        else
+        {
+            maxerr_ = std::max(maxerr_, err);
+        }
+    }
+
+    return static_cast<double>(nfallback_) / (nnodes_ - 1);
+}
+
+
+inline void ThermoTable::interpolate(int j, double t, double *cp_bar, double *h_bar) const
+{
+    const double *cp0 = &cp_[j * n_];
+    const double *cp1 = cp0 + n_;
+    const double *h0  = &h_[j * n_];
+    const double *h1  = h0 + n_;
+
+    if(mode_ != ThermoMode::TableCubic)
+    {
+        double w0 = 1.0 - t;
+        for(int i = 0; i < n_; i++)
+        {
+            cp_bar[i] = w0 * cp0[i] + t * cp1[i];
+            h_bar[i]  = w0 * h0[i]  + t * h1[i];
+        }
+        return;
+    }
+
+    /* Cubic Hermite basis; slopes scaled by the interval width */
+    double s   = 1.0 - t;
+    double b00 = (1.0 + 2.0 * t) * s * s;
+    double b10 = t * s * s * dT_;
+    double b01 = t * t * (3.0 - 2.0 * t);
+    double b11 = -t * t * s * dT_;
+
+    const double *d0 = &dcp_[j * n_];
+    const double *d1 = d0 + n_;
+    for(int i = 0; i < n_; i++)
+    {
+        cp_bar[i] = b00 * cp0[i] + b10 * d0[i]  + b01 * cp1[i] + b11 * d1[i];
+        h_bar[i]  = b00 * h0[i]  + b10 * cp0[i] + b01 * h1[i]  + b11 * cp1[i];  /* dh/dT = cp */
+    }
+}
+
+
+inline int ThermoTable::locate(double T, double &t) const
+{
+    double x = (T - Tmin_) * invdT_;
+    if(!(x >= 0.0 && x < nnodes_ - 1))                                          /* Before the cast: also rejects NaN */
+    {
+        return -1;
+    }
+
+    int j = static_cast<int>(x);
+    if(exact_[j])
+    {
+        return -1;
+    }
+
+    t = x - j;
+    return j;
+}
+
+
+bool ThermoTable::evaluate(double T, double *cp_bar, double *h_bar, double *cp, double *h) const
+{
+    double t;
+    int    j = locate(T, t);
+    if(j < 0)
+    {
+        return false;
+    }
+
+    interpolate(j, t, cp_bar, h_bar);
+    for(int i = 0; i < n_; i++)
+    {
+        cp[i] = cp_bar[i] * invMW_[i];
+        h[i]  = h_bar[i]  * invMW_[i];
+    }
+
+    return true;
+}
+
+
+bool ThermoTable::evaluateCpDerivative(double T, double *dcp_bardT) const
+{
+    double t;
+    int    j = locate(T, t);
+    if(j < 0)
+    {
+        return false;
+    }
+
+    const double *cp0 = &cp_[j * n_];
+    const double *cp1 = cp0 + n_;
+
+    if(mode_ != ThermoMode::TableCubic)
+    {
+        for(int i = 0; i < n_; i++)
+        {
+            dcp_bardT[i] = (cp1[i] - cp0[i]) * invdT_;
+        }
+        return true;
+    }
+
+    /* d/dT of the Hermite basis in interpolate() */
+    double s   = 1.0 - t;
+    double d00 = -6.0 * t * s * invdT_;
+    double d10 = s * (1.0 - 3.0 * t);
+    double d01 = -d00;
+    double d11 = t * (3.0 * t - 2.0);
+
+    const double *d0 = &dcp_[j * n_];
+    const double *d1 = d0 + n_;
+    for(int i = 0; i < n_; i++)
+    {
+        dcp_bardT[i] = d00 * cp0[i] + d10 * d0[i] + d01 * cp1[i] + d11 * d1[i];
+    }
+
+    return true;
+}
+
+
+double ThermoTable::getSpacing() const
+{
+    return dT_;
+}
+
+
+double ThermoTable::getMaxError() const
+{
+    return maxerr_;
+}
+
+
+int ThermoTable::getNumberofFallbackIntervals() const
+{
+    return nfallback_;
+}
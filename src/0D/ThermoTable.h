@@ -0,0 +1,132 @@
+/**
+ * @file ThermoTable.h
+ * @brief Uniform-temperature lookup tables for cp and h with linear or cubic interpolation.
+ * @details
+ *   Built once from the exact thermo path (NASA7Thermo or chemgen) on a uniform
+ *   grid between ChemConfig::THERMO_TABLE_TMIN and THERMO_TABLE_TMAX. Every
+ *   interval is checked against the exact path at its quarter points; the grid
+ *   is halved until the error bound holds everywhere except in intervals
+ *   containing a NASA midpoint kink, which are flagged and answered by the
+ *   exact path (at most ChemConfig::THERMO_TABLE_MAX_FALLBACK of the range).
+ *
+ *   The cubic mode is Hermite interpolation: h uses cp = dh/dT as its slope,
+ *   cp uses a central-difference dcp/dT stored per node.
+ *
+ *   Rate constants are not tabulated. chemgen has per-reaction k_f(T) functions
+ *   (call_forward_reaction_k() in reactions.h), but source_species() calls them,
+ *   and the Gibbs energies for k_r, itself on every call and accepts no
+ *   precomputed values, so a table of them could not be fed back in.
+ */
+
+#ifndef SRC_REACTOR_THERMO_TABLE
+#define SRC_REACTOR_THERMO_TABLE
+
+#include <vector>
+#include <functional>
+
+
+/**
+ * @brief How the reactor evaluates cp and h.
+ */
+enum class ThermoMode
+{
+    Exact,                                                                      /*!< NASA7Thermo kernel, else chemgen.           */
+    TableLinear,                                                                /*!< Linear interpolation in a uniform T table.  */
+    TableCubic                                                                  /*!< Cubic Hermite interpolation (fewer nodes).  */
+};
+
+
+/**
+ * @class ThermoTable
+ * @brief Node-major cp/h table: the species values of one node are contiguous.
+ */
+class ThermoTable
+{
+    public:
+        /**
+         * @brief Exact molar cp and h of every species at T, used to build and check the table.
+         */
+        using ExactThermo = std::function<void(double T, double *cp_bar, double *h_bar)>;
+
+        /**
+         * @brief Empty table; evaluate() always defers to the exact path.
+         */
+        ThermoTable();
+
+        /**
+         * @brief Build and check a table.
+         * @param[in] n Number of species.
+         * @param[in] MW Molecular weights (length n).
+         * @param[in] mode TableLinear or TableCubic.
+         * @param[in] rtol Relative error bound against @p exact (h relative to |h| + cp*T).
+         * @param[in] exact Exact thermo; only used during construction.
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         */
+        ThermoTable(int n, const double *MW, ThermoMode mode, double rtol, const ExactThermo &exact, int debug = 0);
+
+        /**
+         * @brief Interpolate cp and h of every species at @p T.
+         * @return false if @p T is outside the table or in a flagged interval; outputs untouched.
+         */
+        bool evaluate(double T, double *cp_bar, double *h_bar, double *cp, double *h) const;
+
+        /**
+         * @brief d(cp_bar)/dT of the interpolant itself at @p T.
+         * @param[in] T Temperature [K].
+         * @param[out] dcp_bardT Slope of the tabulated molar cp (length n).
+         * @return false where evaluate() would return false; output untouched.
+         * @note The Jacobian must use this slope whenever the RHS used the table:
+         *       mixing table values with an exact derivative leaves the table error
+         *       divided by the difference step.
+         */
+        bool evaluateCpDerivative(double T, double *dcp_bardT) const;
+
+        /* Debugger, getter fns */
+        double getSpacing() const;                                              /*!< Final grid spacing [K].                   */
+        double getMaxError() const;                                             /*!< Largest checked error outside flagged intervals. */
+        int    getNumberofFallbackIntervals() const;                            /*!< Intervals answered by the exact path.     */
+
+
+    private:
+        int        n_;                                                          /*!< Number of species.                        */
+        ThermoMode mode_;                                                       /*!< Interpolation order.                      */
+        int        nnodes_;                                                     /*!< Grid nodes.                               */
+        double     Tmin_;                                                       /*!< First node [K].                           */
+        double     dT_;                                                         /*!< Node spacing [K].                         */
+        double     invdT_;                                                      /*!< 1 / dT_.                                  */
+        double     maxerr_;                                                     /*!< See getMaxError().                        */
+        int        nfallback_;                                                  /*!< See getNumberofFallbackIntervals().        */
+
+        std::vector<double> cp_;                                                /*!< cp_bar at node j, species i: [j*n + i].   */
+        std::vector<double> h_;                                                 /*!< h_bar, same layout.                       */
+        std::vector<double> dcp_;                                               /*!< dcp_bar/dT, same layout (cubic only).     */
+        std::vector<char>   exact_;                                             /*!< Interval j uses the exact path.           */
+        std::vector<double> invMW_;                                             /*!< 1 / molecular weight.                     */
+
+        int debug_;
+
+        /**
+         * @brief Fill the nodes for spacing @p dT from the exact path.
+         */
+        void build(double dT, const ExactThermo &exact);
+
+        /**
+         * @brief Check every interval at its quarter points, flag those above @p rtol.
+         * @return Fraction of intervals flagged.
+         */
+        double check(double rtol, const ExactThermo &exact);
+
+        /**
+         * @brief Interpolate inside interval @p j at local coordinate @p t in [0, 1].
+         */
+        void interpolate(int j, double t, double *cp_bar, double *h_bar) const;
+
+        /**
+         * @brief Interval of @p T and the local coordinate in it.
+         * @return -1 if @p T is NaN, outside the table or in a flagged interval.
+         */
+        int locate(double T, double &t) const;
+};
+
+
+#endif /* SRC_REACTOR_THERMO_TABLE */
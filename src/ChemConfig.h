@@ -13,6 +13,49 @@ namespace ChemConfig
     inline constexpr double RTOL = 1.0e-4;
     inline constexpr double ATOL = 1.0e-8;
 
+    /* Linear solver */
+    inline constexpr int    SPARSE_NEQ_THRESHOLD = 100;                         /* LinearSolverType::Automatic goes sparse above this NEQ */
+    inline constexpr int    SMALL_LU_MAX_NEQ     = 64;                          /* Largest NEQ with a size-specialized LU (SmallDense)    */
+    inline constexpr int    MIXED_LU_MAX_REFINE  = 2;                           /* Refinement sweeps per solve (MixedDense)               */
+    inline constexpr double MIXED_LU_REFINE_RTOL = 1.0e-6;                      /* Stop refining at ||b - A x|| <= this * ||b||           */
+    inline constexpr double SPARSE_MAX_FILL      = 0.3;                         /* Automatic stays dense above this nnz / NEQ^2           */
+    inline constexpr bool   SPARSE_DILATATION    = true;                        /* Keep the dense -Y_i*dphi/dY_j block (exact sparse J)   */
+    inline constexpr int    SPARSITY_PROBES      = 4;                           /* Random compositions probed for d(omega)/dC couplings  */
+
+    /* Method selection (IntegrationMethod::Automatic), stiffness measured as h*rho(J) */
+    inline constexpr double STIFF_HRHO_TO_BDF     = 0.2;                        /* Adams -> BDF above this                   */
+    inline constexpr double STIFF_HRHO_TO_ADAMS   = 0.02;                       /* BDF -> Adams below this                   */
+    inline constexpr int    STIFFNESS_CHECK_STEPS = 20;                         /* Internal steps between stiffness checks   */
+    inline constexpr int    STIFFNESS_POWER_ITERS = 10;                         /* RHS differences per spectral-radius estimate */
+
+    /* Tabulated thermo (ThermoMode::TableLinear / TableCubic) */
+    inline constexpr double THERMO_TABLE_TMIN         = 200.0;                  /* Kelvin, exact path below              */
+    inline constexpr double THERMO_TABLE_TMAX         = 4000.0;                 /* Kelvin, exact path above              */
+    inline constexpr double THERMO_TABLE_DT           = 10.0;                   /* Initial spacing, halved until the bound holds */
+    inline constexpr double THERMO_TABLE_RTOL         = 1.0e-6;                 /* Default error bound vs. the exact path */
+    inline constexpr long   THERMO_TABLE_MAX_ENTRIES  = 1L << 21;               /* Cap on nodes x species (memory)        */
+    inline constexpr double THERMO_TABLE_MAX_FALLBACK = 0.01;                   /* Range fraction allowed to use the exact path (NASA midpoint kinks) */
+
+    /* ISAT cache (ISATTable), errors measured in scaled [T, Y, P] */
+    inline constexpr double ISAT_TOLERANCE         = 1.0e-4;                    /* Default retrieval error bound          */
+    inline constexpr double ISAT_TEMPERATURE_SCALE = 1000.0;                    /* Kelvin per scaled unit                 */
+    inline constexpr double ISAT_PRESSURE_SCALE    = p0;                        /* Pascal per scaled unit                 */
+    inline constexpr double ISAT_FD_DELTA          = 1.0e-3;                    /* Relative perturbation for the mapping gradient */
+    inline constexpr double ISAT_EOA_MIN_SINGULAR  = 0.5;                       /* Bounds the initial EOA to tol / 0.5 per direction */
+    inline constexpr int    ISAT_MAX_SEARCH        = 256;                       /* Most recently used records tested per query */
+    inline constexpr long   ISAT_MAX_BYTES         = 256L << 20;                /* Record storage cap, LRU eviction beyond */
+
+    /* Jacobian reuse (CVODESSerialIntegrator::setJacobianReuse / setJacobianCache) */
+    inline constexpr long   JAC_MAX_STEPS_SETUP = 20;                           /* Steps between Newton matrix setups (CVODES msbp)   */
+    inline constexpr long   JAC_MAX_STEPS_EVAL  = 51;                           /* Steps between Jacobian evaluations (CVODES msbj)  */
+    inline constexpr double JAC_DGMAX_SETUP     = 0.3;                          /* |gamma/gamma_setup - 1| forcing a setup           */
+    inline constexpr int    JAC_CACHE_SIZE      = 8;                            /* Cached cell Jacobians                             */
+    inline constexpr double JAC_CACHE_RTOL      = 1.0e-2;                       /* Relative state distance accepted for a cached one */
+    inline constexpr int    PREC_KINETIC_LAG    = 5;                            /* Arrowhead setups sharing one d(omega)/dC (no source_jacobian) */
+
+    /* Forward-mode AD Jacobian (ADJacobianAdapter, Reactor<N>) */
+    inline constexpr int    AD_LANES = 8;                                       /* Jacobian columns per dual-number pass */
+
 }
 
 
@@ -16,12 +16,38 @@ sundials_build_src_cvodes="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/cvode
 sundials_build_src_sunlinsol="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunlinsol/dense"
 sundials_build_src_sunmatrix="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunmatrix/dense"
 sundials_build_src_nvector_serial="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/nvector/serial"
+sundials_build_src_sunmatrix_sparse="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunmatrix/sparse"
+sundials_build_src_sunlinsol_klu="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunlinsol/klu"
+sundials_build_src_sunlinsol_spgmr="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunlinsol/spgmr"
+sundials_build_src_sunnonlinsol_fixedpoint="$HOME/abhijeet/10_CVODES/sundials_build_dir/src/sunnonlinsol/fixedpoint"
+
+#Sparse (KLU) linear solver: set to 1 if SUNDIALS was built with KLU enabled
+use_klu=0
+klu_flags=""
+if [ "$use_klu" -eq 1 ]; then
+    klu_flags="-DZEROD_USE_KLU -L $sundials_build_src_sunlinsol_klu -lsundials_sunlinsolklu -lklu"
+fi
+
+#Host-specific SIMD (AVX2/AVX-512 thermo kernels): set to 1 for a binary that only runs on this CPU
+use_native=0
+arch_flags=""
+if [ "$use_native" -eq 1 ]; then
+    arch_flags="-march=native"
+fi
 
 #Source files
 main="main.cpp"
 
 zeroD_reactor="$zeroD/IdealGasConstPressureAdiabaticReactor.cpp"
+zeroD_reactor_fixed="$zeroD/Reactor.cpp"
+zeroD_reactor_batch="$zeroD/ReactorBatch.cpp"
+zeroD_thermo="$zeroD/NASA7Thermo.cpp"
+zeroD_table="$zeroD/ThermoTable.cpp"
 integrator_CVODESSerialIntegrator="$integrator/CVODESSerialIntegrator.cpp"
+integrator_CVODESEnsembleIntegrator="$integrator/CVODESEnsembleIntegrator.cpp"
+integrator_CVODESReactorPool="$integrator/CVODESReactorPool.cpp"
+integrator_ISATTable="$integrator/ISATTable.cpp"
+integrator_SUNLinSolSmallDense="$integrator/SUNLinSolSmallDense.cpp"
 
 
 #Executable
@@ -35,7 +61,9 @@ g++ -I $zeroD -I $integrator -I $adapters -I $chem_config  \
     -I $sundials_build_include              \
     -I $sundials_include                    \
                                             \
+    -std=c++20 -O3 $arch_flags -flto        \
     -Wfatal-errors                          \
+    -pthread                                \
     -o $exec_name                           \
                                             \
     -L "$sundials_build_src_sundials"         \
@@ -43,14 +71,30 @@ g++ -I $zeroD -I $integrator -I $adapters -I $chem_config  \
     -L "$sundials_build_src_nvector_serial" \
     -L "$sundials_build_src_sunlinsol"      \
     -L "$sundials_build_src_sunmatrix"      \
+    -L "$sundials_build_src_sunmatrix_sparse" \
+    -L "$sundials_build_src_sunlinsol_spgmr" \
+    -L "$sundials_build_src_sunnonlinsol_fixedpoint" \
     -lsundials_core                         \
     -lsundials_cvodes                       \
     -lsundials_sunmatrixdense               \
+    -lsundials_sunmatrixsparse              \
     -lsundials_nvecserial                   \
     -lsundials_sunlinsoldense               \
+    -lsundials_sunlinsolspgmr               \
+    -lsundials_sunnonlinsolfixedpoint       \
                                             \
     $main                                   \
     $zeroD_reactor                          \
+    $zeroD_reactor_fixed                    \
+    $zeroD_reactor_batch                    \
+    $zeroD_thermo                           \
+    $zeroD_table                            \
     $integrator_CVODESSerialIntegrator      \
+    $integrator_CVODESEnsembleIntegrator    \
+    $integrator_CVODESReactorPool           \
+    $integrator_ISATTable                   \
+    $integrator_SUNLinSolSmallDense         \
+                                            \
+    $klu_flags                              \
     
 
@@ -0,0 +1,167 @@
+/**
+ * @file ADJacobianAdapter.h
+ * @brief Adapter that gives any scalar-templated model an exact forward-mode AD Jacobian.
+ * @details
+ *   - The model writes its RHS once, templated on the scalar type (see @ref ADModel).
+ *   - evalRHS() runs it with double; evalJacobian() runs it with Dual<L>, seeding L
+ *     columns per pass, so the dense Jacobian takes ceil(NEQ / L) passes. Every
+ *     derivative taken through the model's templated code is exact to rounding (no
+ *     perturbation size, no conditioning loss at small mass fractions); derivatives
+ *     the model supplies for double-only code are as exact as the model makes them.
+ *   - Plugs into every Utility integrator as the CVODES Jacobian function.
+ *   - Keeps ownership external (stores a reference).
+ *
+ *   A model can only be differentiated through code it templates itself: calls into
+ *   double-only libraries (e.g. chemgen's source_species()) have no derivative lanes
+ *   and must be lifted onto them with their own derivatives. For Reactor<N>, the only
+ *   model so far, the concentrations, cp, h and the energy/species assembly are exact;
+ *   d(omega)/dC is exact when chemgen provides source_jacobian() and a difference
+ *   quotient otherwise; d(omega)/dT is always a difference quotient, so the
+ *   temperature column and the chemistry part of every species column carry
+ *   difference-quotient error (about 1e-7 relative).
+ *   New models (constant-volume, reactor networks) should keep their kinetics in
+ *   templated code to use this path.
+ */
+
+#ifndef SRC_INCLUDE_ADAPTERS_AD_JACOBIAN_ADAPTER_H
+#define SRC_INCLUDE_ADAPTERS_AD_JACOBIAN_ADAPTER_H
+
+#include <concepts>
+#include <vector>
+
+/* Headers */
+#include "Utility.h"
+#include "Dual.h"
+#include "ChemConfig.h"                                                         /* AD_LANES */
+
+
+/**
+ * @brief Model whose RHS is templated on the scalar type, in the [y] layout of its choice.
+ * @details Requires setNEQ(), setInitialState(double*) and
+ *          template<class S> void evalRHS(double t, const S *y, S *ydot).
+ */
+template<typename M, int L>
+concept ADModel = requires(M m, double t, double *y, const double *yc, const Dual<L> *yd, Dual<L> *fd)
+{
+    { m.setNEQ() } -> std::convertible_to<int>;
+    m.setInitialState(y);
+    m.template evalRHS<double>(t, yc, y);
+    m.template evalRHS<Dual<L>>(t, yd, fd);
+};
+
+
+/**
+ * @class ADJacobianAdapter
+ * @brief Utility adapter with an automatic-differentiation Jacobian.
+ * @tparam Model Model type satisfying @ref ADModel.
+ * @tparam L Jacobian columns per pass (derivative lanes). (default: ChemConfig::AD_LANES)
+ */
+template<typename Model, int L = ChemConfig::AD_LANES>
+    requires ADModel<Model, L>
+class ADJacobianAdapter : public Utility
+{
+    public:
+        /**
+         * @brief Construct the adapter around an existing model.
+         * @param[in] m Model instance to be adapted (non-owning reference).
+         * @pre @p m must outlive this adapter.
+         */
+        explicit ADJacobianAdapter(Model &m) : m_(m), NEQ_(m.setNEQ()), yd_(NEQ_), fd_(NEQ_) {}
+
+        /**
+         * @brief Set the number of ODE equations.
+         * @return Dimension of the system as provided by the model.
+         */
+        int setNEQ() override
+        {
+            return NEQ_;
+        }
+
+        /**
+         * @brief Write initial state into the provided buffer.
+         * @param[out] y State vector (length = setNEQ()).
+         */
+        void setInitialState(double *y) override
+        {
+            m_.setInitialState(y);
+        }
+
+        /**
+         * @brief Evaluate the ODE right-hand side with doubles.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[out] ydot Derivative vector (length = setNEQ()).
+         */
+        void evalRHS(double t, double *y, double *ydot) override
+        {
+            m_.template evalRHS<double>(t, y, ydot);
+        }
+
+        /**
+         * @brief Load a new cell state into the model.
+         * @throws std::logic_error if the model has no setCellState() (see Utility).
+         */
+        void setCellState(double temperature, double pressure, const double *Y) override
+        {
+            if constexpr (requires { m_.setCellState(temperature, pressure, Y); })
+            {
+                m_.setCellState(temperature, pressure, Y);
+            }
+            else
+            {
+                Utility::setCellState(temperature, pressure, Y);
+            }
+        }
+
+        /**
+         * @brief The AD Jacobian is always available.
+         * @return true.
+         */
+        bool hasJacobian() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Exact Jacobian by forward-mode AD, L columns per pass.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS at (t, y) (unused: the passes recompute it).
+         * @param[out] J Column-major NEQ×NEQ Jacobian.
+         */
+        void evalJacobian(double t, double *y, double *ydot, double *J) override
+        {
+            for(int j0 = 0; j0 < NEQ_; j0 += L)
+            {
+                /* Seed columns j0..j0+L-1 */
+                for(int i = 0; i < NEQ_; i++)
+                {
+                    yd_[i] = Dual<L>(y[i]);
+                }
+                for(int q = 0; q < L && j0 + q < NEQ_; q++)
+                {
+                    yd_[j0 + q].d[q] = 1.0;
+                }
+
+                m_.template evalRHS<Dual<L>>(t, yd_.data(), fd_.data());
+
+                for(int q = 0; q < L && j0 + q < NEQ_; q++)
+                {
+                    double *col = &J[(j0 + q) * NEQ_];
+                    for(int i = 0; i < NEQ_; i++)
+                    {
+                        col[i] = fd_[i].d[q];
+                    }
+                }
+            }
+        }
+
+    private:
+        Model                &m_;                                               ///< Non-owning reference to the wrapped model.
+        int                   NEQ_;                                             ///< Number of equations.
+        std::vector<Dual<L>>  yd_;                                              ///< Seeded state.
+        std::vector<Dual<L>>  fd_;                                              ///< RHS with derivative lanes.
+};
+
+
+#endif
@@ -10,6 +10,7 @@
 #define SRC_INCLUDE_ADAPTERS_IDEAL_GAS_CONST_PRESSURE_ADIABATIC_REACTOR_H
 
 #include <iostream>
+#include <vector>
 
 /* Headers */
 #include "Utility.h"
@@ -72,10 +73,220 @@ class IdealGasConstPressureAdiabaticReactorAdapter : public Utility
             r_.evalRHS(t, y, ydot);
         } 
 
+        /**
+         * @brief Load a new cell state into the reactor.
+         * @param[in] temperature Cell temperature [K].
+         * @param[in] pressure Cell pressure [Pa].
+         * @param[in] Y Cell mass fractions.
+         */
+        void setCellState(double temperature, double pressure, const double *Y) override
+        {
+            r_.setCellState(temperature, pressure, Y);
+        }
+
+        /**
+         * @brief Choose exact or tabulated cp/h in the reactor.
+         * @param[in] mode Exact, TableLinear or TableCubic.
+         * @param[in] rtol Error bound of the table against the exact path.
+         */
+        void setThermoMode(ThermoMode mode, double rtol = ChemConfig::THERMO_TABLE_RTOL)
+        {
+            r_.setThermoMode(mode, rtol);
+        }
+
+        /**
+         * @brief The reactor provides a semi-analytic Jacobian.
+         * @return true.
+         */
+        bool hasJacobian() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Evaluate the Jacobian d(ydot)/dy.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS at (t, y).
+         * @param[out] J Column-major NEQ×NEQ Jacobian.
+         */
+        void evalJacobian(double t, double *y, double *ydot, double *J) override
+        {
+            r_.evalJacobian(t, y, ydot, J);
+        }
+
+        /**
+         * @brief The reactor provides a sparse Jacobian pattern.
+         * @return true.
+         */
+        bool hasJacobianPattern() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Return the reactor's CSC Jacobian pattern.
+         * @param[out] colptrs Column pointers (length = setNEQ() + 1).
+         * @param[out] rowvals Row indices.
+         */
+        void getJacobianPattern(std::vector<int> &colptrs, std::vector<int> &rowvals) override
+        {
+            r_.getJacobianPattern(colptrs, rowvals);
+        }
+
+        /**
+         * @brief Evaluate the Jacobian values on the reactor's pattern.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS at (t, y).
+         * @param[out] data Nonzero values in pattern order.
+         */
+        void evalSparseJacobian(double t, double *y, double *ydot, double *data) override
+        {
+            r_.evalSparseJacobian(t, y, ydot, data);
+        }
+
+        /**
+         * @brief The reactor provides an arrowhead Jacobian approximation.
+         * @return true.
+         */
+        bool hasJacobianArrowhead() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Evaluate the T row, T column and diagonal of the reactor Jacobian.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS at (t, y).
+         * @param[out] diag Diagonal.
+         * @param[out] row0 Temperature row.
+         * @param[out] col0 Temperature column.
+         */
+        void evalJacobianArrowhead(double t, double *y, double *ydot,
+                                   double *diag, double *row0, double *col0) override
+        {
+            r_.evalJacobianArrowhead(t, y, ydot, diag, row0, col0);
+        }
+
+        /**
+         * @brief Number of reactor parameters: 1, the global rate multiplier (global-rate sensitivity).
+         */
+        int getNumParameters() override
+        {
+            return r_.getNumParameters();
+        }
+
+        /**
+         * @brief Live reactor parameter storage.
+         */
+        double *getParameters() override
+        {
+            return r_.getParameters();
+        }
+
+        /**
+         * @brief The reactor provides d(ydot)/dp analytically.
+         * @return true.
+         */
+        bool hasParameterDerivative() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Evaluate d(ydot)/d(p_k).
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t.
+         * @param[in] ydot RHS at (t, y).
+         * @param[in] k Parameter index.
+         * @param[out] dfdp Derivative of the RHS w.r.t. p_k.
+         */
+        void evalParameterDerivative(double t, double *y, double *ydot, int k, double *dfdp) override
+        {
+            r_.evalParameterDerivative(t, y, ydot, k, dfdp);
+        }
+
     private:
         IdealGasConstPressureAdiabaticReactor &r_;                              ///< Non-owning reference to the wrapped reactor.
         int debug_ = 0;                                                         ///< Debug verbosity: 0 = quiet, 1 = prints constructor msg.
 };
 
 
+/**
+ * @class IdealGasConstPressureAdiabaticReactorSharedAdapter
+ * @brief Utility adapter over a shared, read-only reactor and a per-cell workspace.
+ * @details
+ *   Uses only the const entry points (setCellState(..., ws), evalRHS(..., ws)), so
+ *   any number of these adapters (e.g. one per CVODESReactorPool worker) can wrap
+ *   the same reactor concurrently. No Jacobian hooks: the semi-analytic Jacobian needs
+ *   the reactor's own scratch, so the integrator uses difference quotients.
+ */
+class IdealGasConstPressureAdiabaticReactorSharedAdapter : public Utility
+{
+    public:
+        /**
+         * @brief Construct the adapter around a shared reactor, starting from its current cell.
+         * @param[in] r Reactor shared read-only (non-owning reference).
+         * @pre @p r must outlive this adapter and must not be modified while adapters use it.
+         */
+        explicit IdealGasConstPressureAdiabaticReactorSharedAdapter
+        (const IdealGasConstPressureAdiabaticReactor &r) : r_(r)
+        {
+            std::vector<double> y(r_.setNEQ());
+            r_.setInitialState(y.data());
+            r_.setCellState(y[0], r_.getPressure(), &y[1], ws_);
+        }
+
+        /**
+         * @brief Set the number of ODE equations.
+         * @return Dimension of the system as provided by the reactor.
+         */
+        int setNEQ() override
+        {
+            return r_.setNEQ();
+        }
+
+        /**
+         * @brief Write the workspace's cell state into the provided buffer.
+         * @param[out] y State vector (length = setNEQ()); layout [T, Y1..Y_N].
+         */
+        void setInitialState(double *y) override
+        {
+            y[0] = ws_.T;
+            for(int i = 1; i < r_.setNEQ(); i++)
+            {
+                y[i] = ws_.Y[i - 1];
+            }
+        }
+
+        /**
+         * @brief Evaluate the ODE right-hand side into this adapter's workspace.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[out] ydot Derivative vector (length = setNEQ()).
+         */
+        void evalRHS(double t, double *y, double *ydot) override
+        {
+            r_.evalRHS(t, y, ydot, ws_);
+        }
+
+        /**
+         * @brief Load a new cell state into this adapter's workspace.
+         * @param[in] temperature Cell temperature [K].
+         * @param[in] pressure Cell pressure [Pa].
+         * @param[in] Y Cell mass fractions.
+         */
+        void setCellState(double temperature, double pressure, const double *Y) override
+        {
+            r_.setCellState(temperature, pressure, Y, ws_);
+        }
+
+    private:
+        const IdealGasConstPressureAdiabaticReactor &r_;                        ///< Shared read-only reactor.
+        ReactorWorkspace                            ws_;                        ///< This adapter's cell scratch.
+};
+
+
 #endif
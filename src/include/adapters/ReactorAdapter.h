@@ -0,0 +1,79 @@
+/**
+ * @file ReactorAdapter.h
+ * @brief Adapter that exposes Reactor<NSpecies> via the Utility interface.
+ * @details
+ *   - Delegates Utility API calls to an underlying Reactor<NSpecies> instance.
+ *   - Keeps ownership external (stores a reference).
+ *   - No Jacobian hooks: the integrator falls back to difference quotients.
+ */
+
+#ifndef SRC_INCLUDE_ADAPTERS_REACTOR_ADAPTER_H
+#define SRC_INCLUDE_ADAPTERS_REACTOR_ADAPTER_H
+
+/* Headers */
+#include "Utility.h"
+#include "Reactor.h"
+
+
+/**
+ * @class ReactorAdapter
+ * @brief Utility-interface adapter for the compile-time sized Reactor.
+ * @tparam NSpecies Species count of the wrapped reactor.
+ */
+template<int NSpecies>
+class ReactorAdapter : public Utility
+{
+    public:
+        /**
+         * @brief Construct the adapter around an existing reactor.
+         * @param[in] r Reactor instance to be adapted (non-owning reference).
+         * @pre @p r must outlive this adapter.
+         */
+        explicit ReactorAdapter(Reactor<NSpecies> &r) : r_(r) {}
+
+        /**
+         * @brief Set the number of ODE equations.
+         * @return Reactor<NSpecies>::NEQ.
+         */
+        int setNEQ() override
+        {
+            return Reactor<NSpecies>::NEQ;
+        }
+
+        /**
+         * @brief Write the reactor's state into the provided buffer.
+         * @param[out] y State vector (length = setNEQ()).
+         */
+        void setInitialState(double *y) override
+        {
+            r_.setInitialState(y);
+        }
+
+        /**
+         * @brief Evaluate the ODE right-hand side.
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[out] ydot Derivative vector (length = setNEQ()).
+         */
+        void evalRHS(double t, double *y, double *ydot) override
+        {
+            r_.evalRHS(t, y, ydot);
+        }
+
+        /**
+         * @brief Load a new cell state into the reactor.
+         * @param[in] temperature Cell temperature [K].
+         * @param[in] pressure Cell pressure [Pa].
+         * @param[in] Y Cell mass fractions.
+         */
+        void setCellState(double temperature, double pressure, const double *Y) override
+        {
+            r_.setCellState(temperature, pressure, Y);
+        }
+
+    private:
+        Reactor<NSpecies> &r_;                                                  ///< Non-owning reference to the wrapped reactor.
+};
+
+
+#endif
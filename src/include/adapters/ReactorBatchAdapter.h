@@ -0,0 +1,189 @@
+/**
+ * @file ReactorBatchAdapter.h
+ * @brief Adapter that exposes a ReactorBatch<W> as one Utility model of W*NEQ equations.
+ * @details
+ *   - State layout is the batch's structure of arrays: y[k*W + l] is component k of cell l.
+ *   - The W cells are independent, so the Jacobian is block diagonal (one NEQ×NEQ
+ *     block per cell, interleaved). It is built by difference quotients that perturb
+ *     component k of all cells at once: NEQ batched RHS calls give every block.
+ *   - Sparse path only: the blocks are offered as a sparse pattern and no dense
+ *     Jacobian is provided, so CVODESSerialIntegrator factors W independent NEQ×NEQ
+ *     blocks with KLU instead of one (W*NEQ)² dense matrix. Without KLU it falls
+ *     back to a dense difference-quotient Jacobian; use per-cell models there.
+ *   - Error control changes: CVODES measures the local error with one WRMS norm over
+ *     all W*NEQ components, which would let a single cell exceed its tolerance by up
+ *     to sqrt(W). getToleranceScale() tightens the tolerances by 1/sqrt(W) so every
+ *     cell stays within the requested tolerance, at the price of steps the other
+ *     cells do not need.
+ *   - The cells share one step size, which the stiffest cell sets; group cells of
+ *     similar state into one batch.
+ *   - Only the RHS algebra is vectorized: chemgen's source_species() is scalar and
+ *     still runs once per lane (see ReactorBatch).
+ *   - Keeps ownership external (stores a reference).
+ */
+
+#ifndef SRC_INCLUDE_ADAPTERS_REACTOR_BATCH_ADAPTER_H
+#define SRC_INCLUDE_ADAPTERS_REACTOR_BATCH_ADAPTER_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/* Headers */
+#include "Utility.h"
+#include "ReactorBatch.h"
+
+
+/**
+ * @class ReactorBatchAdapter
+ * @brief Utility-interface adapter for a W-cell batch.
+ * @tparam W Cells per batch.
+ */
+template<int W>
+class ReactorBatchAdapter : public Utility
+{
+    public:
+        static constexpr int NEQ_CELL = ReactorBatch<W>::NEQ;                   ///< Equations per cell.
+        static constexpr int NEQ      = W * NEQ_CELL;                           ///< Equations of the batch.
+
+        /**
+         * @brief Construct the adapter around an existing batch.
+         * @param[in] b Batch to be adapted (non-owning reference).
+         * @pre @p b must outlive this adapter.
+         */
+        explicit ReactorBatchAdapter(ReactorBatch<W> &b) : b_(b), yp_(NEQ), fp_(NEQ) {}
+
+        /**
+         * @brief Set the number of ODE equations.
+         * @return W * NEQ of one cell.
+         */
+        int setNEQ() override
+        {
+            return NEQ;
+        }
+
+        /**
+         * @brief Write the lanes' loaded states into the provided buffer.
+         * @param[out] y Batch state (length = setNEQ()).
+         */
+        void setInitialState(double *y) override
+        {
+            b_.setInitialState(y);
+        }
+
+        /**
+         * @brief Evaluate the RHS of all cells of the batch.
+         * @param[in] t Current time.
+         * @param[in] y Batch state at time @p t (length = setNEQ()).
+         * @param[out] ydot Batch RHS (length = setNEQ()).
+         */
+        void evalRHS(double t, double *y, double *ydot) override
+        {
+            b_.evalRHS(y, ydot);
+        }
+
+        /**
+         * @brief Load one cell into a lane; restart the integrator afterwards
+         *        (CVODESSerialIntegrator::reset()).
+         * @param[in] lane Lane index.
+         * @param[in] temperature Cell temperature [K].
+         * @param[in] pressure Cell pressure [Pa].
+         * @param[in] Y Cell mass fractions.
+         */
+        void setLaneState(int lane, double temperature, double pressure, const double *Y)
+        {
+            b_.setCellState(lane, temperature, pressure, Y);
+        }
+
+        /**
+         * @brief Tolerance factor for the stacked cells.
+         * @return 1/sqrt(W), see the file details.
+         */
+        double getToleranceScale() override
+        {
+            return 1.0 / std::sqrt(static_cast<double>(W));
+        }
+
+        /**
+         * @brief The block-diagonal pattern is provided.
+         * @return true.
+         */
+        bool hasJacobianPattern() override
+        {
+            return true;
+        }
+
+        /**
+         * @brief CSC pattern: column k*W + l has rows r*W + l, r = 0..NEQ_CELL-1.
+         * @param[out] colptrs Column pointers (length = setNEQ() + 1).
+         * @param[out] rowvals Row indices, sorted within each column.
+         */
+        void getJacobianPattern(std::vector<int> &colptrs, std::vector<int> &rowvals) override
+        {
+            colptrs.assign(NEQ + 1, 0);
+            rowvals.resize(NEQ * NEQ_CELL);
+
+            for(int j = 0; j < NEQ; j++)
+            {
+                int l = j % W;
+                colptrs[j + 1] = colptrs[j] + NEQ_CELL;
+                for(int r = 0; r < NEQ_CELL; r++)
+                {
+                    rowvals[colptrs[j] + r] = r * W + l;
+                }
+            }
+        }
+
+        /**
+         * @brief Jacobian values on the pattern of getJacobianPattern().
+         * @param[in] t Current time.
+         * @param[in] y Batch state.
+         * @param[in] ydot RHS at (t, y).
+         * @param[out] data Nonzero values, in pattern order.
+         */
+        void evalSparseJacobian(double t, double *y, double *ydot, double *data) override
+        {
+            for(int k = 0; k < NEQ_CELL; k++)
+            {
+                perturbComponent(k, y, ydot);
+                for(int l = 0; l < W; l++)
+                {
+                    int j = k * W + l;
+                    for(int r = 0; r < NEQ_CELL; r++)
+                    {
+                        int i = r * W + l;
+                        data[j * NEQ_CELL + r] = (fp_[i] - ydot[i]) / inc_[l];
+                    }
+                }
+            }
+        }
+
+    private:
+        ReactorBatch<W>    &b_;                                                 ///< Non-owning reference to the wrapped batch.
+        std::vector<double> yp_;                                                ///< Perturbed state.
+        std::vector<double> fp_;                                                ///< RHS at the perturbed state.
+        double              inc_[W];                                            ///< Increment of each lane.
+
+        /**
+         * @brief fp_ = RHS with component @p k of every cell perturbed; increments in inc_.
+         */
+        void perturbComponent(int k, const double *y, const double *ydot)
+        {
+            const double srur = std::sqrt(std::numeric_limits<double>::epsilon());
+
+            std::copy(y, y + NEQ, yp_.begin());
+            for(int l = 0; l < W; l++)
+            {
+                int j   = k * W + l;
+                inc_[l] = srur * std::max(std::fabs(y[j]), 1.0e-3);
+                yp_[j] += inc_[l];
+                inc_[l] = yp_[j] - y[j];                                        /* Exactly representable step */
+            }
+
+            b_.evalRHS(yp_.data(), fp_.data());
+        }
+};
+
+
+#endif
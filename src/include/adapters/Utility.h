@@ -10,6 +10,8 @@
 
 
 /* Headers? */
+#include <vector>
+#include <stdexcept>
 
 
 /* Virtual fns because I can change their dfns in the derived class */
@@ -50,6 +52,117 @@ class Utility
          */
         virtual void evalRHS(double t, double *y, double *ydot) = 0;            
 
+        /**
+         * @brief Load a new thermochemical cell state (optional, reacting-flow models).
+         * @param[in] temperature Cell temperature [K].
+         * @param[in] pressure Cell pressure [Pa].
+         * @param[in] Y Cell mass fractions (length = number of species).
+         * @post A following setInitialState() returns this state.
+         * @note Used by ensemble/pool drivers that reuse one model for many CFD cells.
+         * @throws std::logic_error by default: a model that cannot load cells must not
+         *         be handed to those drivers, which would integrate a stale state.
+         */
+        virtual void setCellState(double temperature, double pressure, const double *Y)
+        {
+            throw std::logic_error("Utility::setCellState(): this model cannot load a cell state");
+        }
+
+        /**
+         * @brief Whether the model provides an analytic Jacobian via evalJacobian().
+         * @return true if evalJacobian() is implemented; false (default) lets the
+         *         integrator fall back to its internal difference-quotient Jacobian.
+         */
+        virtual bool hasJacobian() { return false; }
+
+        /**
+         * @brief Evaluate the Jacobian d(ydot)/dy (optional).
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS already evaluated at (t, y) by the integrator.
+         * @param[out] J Column-major NEQ×NEQ array, J[j*NEQ + i] = d(ydot_i)/d(y_j).
+         * @pre Only called when hasJacobian() returns true.
+         */
+        virtual void evalJacobian(double t, double *y, double *ydot, double *J) {}
+
+        /**
+         * @brief Whether the model provides a sparse Jacobian via evalSparseJacobian().
+         * @return true if getJacobianPattern()/evalSparseJacobian() are implemented.
+         */
+        virtual bool hasJacobianPattern() { return false; }
+
+        /**
+         * @brief Return the CSC sparsity pattern of the Jacobian (optional).
+         * @param[out] colptrs Column pointers (length = setNEQ() + 1).
+         * @param[out] rowvals Row indices, sorted within each column; must include the diagonal.
+         */
+        virtual void getJacobianPattern(std::vector<int> &colptrs, std::vector<int> &rowvals) {}
+
+        /**
+         * @brief Evaluate the Jacobian values on the pattern of getJacobianPattern() (optional).
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS already evaluated at (t, y) by the integrator.
+         * @param[out] data Nonzero values, in the order of the pattern's row indices.
+         * @pre Only called when hasJacobianPattern() returns true.
+         */
+        virtual void evalSparseJacobian(double t, double *y, double *ydot, double *data) {}
+
+        /**
+         * @brief Whether the model provides evalJacobianArrowhead() for preconditioning.
+         * @return true if evalJacobianArrowhead() is implemented.
+         */
+        virtual bool hasJacobianArrowhead() { return false; }
+
+        /**
+         * @brief Evaluate the first row, first column and diagonal of the Jacobian (optional).
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS already evaluated at (t, y) by the integrator.
+         * @param[out] diag diag[i] = d(ydot_i)/d(y_i) (length = setNEQ()).
+         * @param[out] row0 row0[j] = d(ydot_0)/d(y_j) (length = setNEQ()).
+         * @param[out] col0 col0[i] = d(ydot_i)/d(y_0) (length = setNEQ()).
+         * @details Used as an "arrowhead" preconditioner by the matrix-free Krylov path;
+         *          implementations should cost O(NEQ) memory.
+         */
+        virtual void evalJacobianArrowhead(double t, double *y, double *ydot,
+                                           double *diag, double *row0, double *col0) {}
+
+        /**
+         * @brief Number of model parameters exposed for sensitivity analysis (optional).
+         * @return Number of entries behind getParameters(); 0 disables sensitivities.
+         */
+        virtual int getNumParameters() { return 0; }
+
+        /**
+         * @brief Live parameter storage read by evalRHS() (optional).
+         * @return Pointer to getNumParameters() values; CVODES may perturb them in place.
+         */
+        virtual double *getParameters() { return nullptr; }
+
+        /**
+         * @brief Whether evalParameterDerivative() is implemented.
+         * @return true to let the integrator use analytic d(ydot)/dp in the sensitivity RHS.
+         */
+        virtual bool hasParameterDerivative() { return false; }
+
+        /**
+         * @brief Evaluate d(ydot)/d(p_k) (optional).
+         * @param[in] t Current time.
+         * @param[in] y State vector at time @p t (length = setNEQ()).
+         * @param[in] ydot RHS already evaluated at (t, y).
+         * @param[in] k Parameter index.
+         * @param[out] dfdp d(ydot)/d(p_k) (length = setNEQ()).
+         */
+        virtual void evalParameterDerivative(double t, double *y, double *ydot, int k, double *dfdp) {}
+
+        /**
+         * @brief Factor the integrator applies to its relative and absolute tolerances (optional).
+         * @return 1 by default. A model that stacks k independent systems into one state
+         *         returns 1/sqrt(k): the integrator's WRMS norm averages over all of them,
+         *         so this keeps every subsystem's own norm within the requested tolerance.
+         */
+        virtual double getToleranceScale() { return 1.0; }
+
         /* virtual void setState(double *y, double temperature) = 0; */
 
         /* CVODES fns */
@@ -0,0 +1,177 @@
+#include "CVODESEnsembleIntegrator.h"
+#include "SUNDIALSHelpers.h"
+#include "ChemConfig.h"
+
+#include <stdexcept>
+#include <string>
+
+
+CVODESEnsembleIntegrator::CVODESEnsembleIntegrator(std::vector<Utility*> cells, int debug)
+{
+    NEQ_    = cells.empty() ? 0 : cells[0]->setNEQ();
+    RTOL_   = ChemConfig::RTOL * (cells.empty() ? 1.0 : cells[0]->getToleranceScale());
+    ATOL_   = ChemConfig::ATOL * (cells.empty() ? 1.0 : cells[0]->getToleranceScale());
+    sunctx_ = nullptr;
+    ready_  = false;
+    debug_  = debug;
+
+    cells_.resize(cells.size());
+    for(size_t c = 0; c < cells.size(); c++)
+    {
+        cells_[c].model = cells[c];
+
+        if(cells[c]->setNEQ() != NEQ_)
+        {
+            throw std::invalid_argument("CVODESEnsembleIntegrator: cell " + std::to_string(c)
+                                        + " has a different NEQ than cell 0");
+        }
+    }
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Constructor of CVODES ensemble implemented! Cells: "<<cells_.size()<<std::endl;
+    }
+}
+
+
+int CVODESEnsembleIntegrator::setupCell(Cell &c)
+{
+    c.time = 0.0;
+    return setupDenseSession(c, c.model, NEQ_, c.time, RTOL_, ATOL_, sunctx_);    /* One dense block per cell */
+}
+
+
+void CVODESEnsembleIntegrator::updateCellStatistics(Cell &c)
+{
+    long nsteps = 0, nrhs = 0, njac = 0, nlinsetups = 0, netfails = 0;         /* Left untouched if a getter fails */
+
+    CVodeGetNumSteps(c.cvode_mem, &nsteps);
+    CVodeGetNumRhsEvals(c.cvode_mem, &nrhs);
+    CVodeGetNumJacEvals(c.cvode_mem, &njac);
+    CVodeGetNumLinSolvSetups(c.cvode_mem, &nlinsetups);
+    CVodeGetNumErrTestFails(c.cvode_mem, &netfails);
+
+    c.stats.nsteps     = c.base.nsteps     + nsteps;
+    c.stats.nrhs       = c.base.nrhs       + nrhs;
+    c.stats.njac       = c.base.njac       + njac;
+    c.stats.nlinsetups = c.base.nlinsetups + nlinsetups;
+    c.stats.netfails   = c.base.netfails   + netfails;
+}
+
+
+/* Public functions */
+int CVODESEnsembleIntegrator::initializeandsetupsolver()
+{
+    SUNContext_Create(SUN_COMM_NULL, &sunctx_);
+
+    for(size_t c = 0; c < cells_.size(); c++)
+    {
+        if(setupCell(cells_[c]))
+        {
+            std::cout<<"--Setup of ensemble cell "<<c<<" failed, ensemble not set up!"<<std::endl;
+            freeMemory();                                                       /* Also the half-built cell */
+            return (1);
+        }
+    }
+    ready_ = true;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Initialized and setup ensemble solver!"<<std::endl;
+    }
+
+    return (0);
+}
+
+
+int CVODESEnsembleIntegrator::advance(double dt)
+{
+    int nfailed = 0;
+
+    if(!ready_)
+    {
+        std::cout<<"--Ensemble is not set up, no cell advanced!"<<std::endl;
+        return cells_.size();
+    }
+
+    for(size_t c = 0; c < cells_.size(); c++)
+    {
+        Cell  &cell = cells_[c];
+        double tout = cell.time + dt;
+
+        CVodeSetStopTime(cell.cvode_mem, tout);                                 /* Never step past tout: transport may change the state */
+        cell.stats.flag = CVode(cell.cvode_mem, tout, cell.y, &cell.time, CV_NORMAL);
+
+        if(check_retval(&cell.stats.flag, "CVode", 1))
+        {
+            std::cout<<"--Error in integration of ensemble cell "<<c<<"!"<<std::endl;
+            nfailed++;
+        }
+
+        updateCellStatistics(cell);
+    }
+
+    return nfailed;
+}
+
+
+void CVODESEnsembleIntegrator::setCellState(int cell, double temperature, double pressure, const double *Y)
+{
+    Cell &c = cells_[cell];
+
+    c.model->setCellState(temperature, pressure, Y);
+    restartCell(cell);
+}
+
+
+void CVODESEnsembleIntegrator::restartCell(int cell)
+{
+    Cell &c = cells_[cell];
+
+    c.model->setInitialState(N_VGetArrayPointer(c.y));
+
+    c.base = c.stats;
+    int flag = CVodeReInit(c.cvode_mem, c.time, c.y);
+    check_retval(&flag, "CVodeReInit", 1);
+}
+
+
+void CVODESEnsembleIntegrator::getCellState(int cell, double *y)
+{
+    double *ydata = N_VGetArrayPointer(cells_[cell].y);
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        y[i] = ydata[i];
+    }
+}
+
+
+const CellStatistics& CVODESEnsembleIntegrator::getCellStatistics(int cell)
+{
+    return cells_[cell].stats;
+}
+
+
+void CVODESEnsembleIntegrator::freeMemory()
+{
+    for(Cell &c : cells_)
+    {
+        freeDenseSession(c);                                                    /* Safe to call freeMemory() again */
+    }
+    SUNContext_Free(&sunctx_);
+    ready_ = false;
+}
+
+
+/* Debugger, getter fns */
+int CVODESEnsembleIntegrator::getNumberofCells()
+{
+    return cells_.size();
+}
+
+
+int CVODESEnsembleIntegrator::getNEQ()
+{
+    return NEQ_;
+}
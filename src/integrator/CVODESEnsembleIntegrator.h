@@ -0,0 +1,149 @@
+/**
+ * @file CVODESEnsembleIntegrator.h
+ * @brief CVODES integrator for an ensemble of independent reactor cells
+ * @details
+ *  Each cell owns its own CVODES session (state, tolerances, NEQ×NEQ dense
+ *  matrix and linear solver) on a shared SUNContext. The ensemble Newton
+ *  system is therefore block diagonal and every block is factored and solved
+ *  on its own, with its own step size and error control: a stiff igniting
+ *  cell does not shrink the steps or force Jacobian updates of inert cells.
+ */
+
+#ifndef SRC_INTEGRATOR_CVODES_ENSEMBLE_INTEGRATOR
+#define SRC_INTEGRATOR_CVODES_ENSEMBLE_INTEGRATOR
+
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+
+#include "SUNDIALSHelpers.h"                                                    /*!< Dense BDF session, CVODES trampolines, check_retval() */
+
+
+/**
+ * @brief Cumulative CVODES statistics of one ensemble cell.
+ */
+struct CellStatistics
+{
+    long nsteps     = 0;                                                        /*!< Internal steps taken.                  */
+    long nrhs       = 0;                                                        /*!< RHS evaluations.                       */
+    long njac       = 0;                                                        /*!< Jacobian evaluations.                  */
+    long nlinsetups = 0;                                                        /*!< Linear solver setups (factorizations). */
+    long netfails   = 0;                                                        /*!< Local error test failures.             */
+    int  flag       = 0;                                                        /*!< Return flag of the last CVode() call.  */
+};
+
+
+/**
+ * @class CVODESEnsembleIntegrator
+ * @brief Advances N independent cells over a common time step.
+ * @details
+ *  Usage:
+ *      1. Construct with one Utility model per cell (models must outlive the integrator).
+ *      2. initializeandsetupsolver().
+ *      3. Per CFD step: setCellState() for cells changed by transport, then advance(dt).
+ */
+class CVODESEnsembleIntegrator
+{
+    public:
+        /**
+         * @brief Construct an ensemble integrator over the given cell models.
+         * @param[in] cells One model per cell (non-owning).
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         * @throws std::invalid_argument if the cells do not all have the same NEQ.
+         */
+        explicit CVODESEnsembleIntegrator (std::vector<Utility*> cells, int debug = 0);
+
+        /**
+         * @brief Allocate one CVODES session per cell from the models' initial states.
+         * @return 0 on success; 1 if any session failed, in which case the sessions
+         *         already created are released and advance() integrates nothing.
+         */
+        int initializeandsetupsolver();
+
+        /**
+         * @brief Advance every cell from its current time by @p dt.
+         * @param[in] dt Common time step [s].
+         * @return Number of cells whose integration failed (flag < 0); every cell if the
+         *         sessions are not set up.
+         * @post Each cell's state is at t + dt; statistics accumulated.
+         */
+        int advance(double dt);
+
+        /**
+         * @brief Replace a cell's thermochemical state and restart its session.
+         * @param[in] cell Cell index.
+         * @param[in] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa].
+         * @param[in] Y Mass fractions.
+         * @pre Model implements @ref Utility::setCellState().
+         */
+        void setCellState(int cell, double temperature, double pressure, const double *Y);
+
+        /**
+         * @brief Restart a cell's session from its model's setInitialState().
+         * @param[in] cell Cell index.
+         * @details For models whose state is loaded another way than setCellState().
+         */
+        void restartCell(int cell);
+
+        /**
+         * @brief Copy a cell's current state vector.
+         * @param[in] cell Cell index.
+         * @param[out] y Model state layout (length = getNEQ()).
+         */
+        void getCellState(int cell, double *y);
+
+        /**
+         * @brief Cumulative statistics of one cell.
+         * @param[in] cell Cell index.
+         */
+        const CellStatistics& getCellStatistics(int cell);
+
+        /**
+         * @brief Release all allocated SUNDIALS resources.
+         * @note Idempotent.
+         */
+        void freeMemory();
+
+        /* Debugger, getter fns */
+        int getNumberofCells();
+        int getNEQ();
+
+
+    private:
+
+        /**
+         * @brief One cell's CVODES session (one diagonal block of the ensemble).
+         */
+        struct Cell : DenseCVODESSession
+        {
+            Utility        *model     = nullptr;                                /*!< Cell model (non-owning). */
+            double          time      = 0.0;                                    /*!< Current cell time [s].   */
+            CellStatistics  stats;                                              /*!< Cumulative statistics.   */
+            CellStatistics  base;                                               /*!< Statistics at last (re)init; CVODES counters restart there. */
+        };
+
+        int    NEQ_;                                                            /*!< Equations per cell.                 */
+        double RTOL_;                                                           /*!< Relative tolerance (scalar).        */
+        double ATOL_;                                                           /*!< Absolute tolerance (all equations). */
+
+        std::vector<Cell> cells_;                                               /*!< Per-cell sessions.                  */
+        SUNContext sunctx_;                                                     /*!< Shared SUNDIALS context.            */
+        bool       ready_;                                                      /*!< Every cell's session is set up.     */
+
+        int debug_;
+
+        /**
+         * @brief Create and configure the CVODES session of one cell.
+         * @return 0 on success, non-zero on failure.
+         */
+        int setupCell(Cell &c);
+
+        /**
+         * @brief Refresh a cell's cumulative statistics from the CVODES counters.
+         */
+        void updateCellStatistics(Cell &c);
+};
+
+
+#endif /* SRC_INTEGRATOR_CVODES_ENSEMBLE_INTEGRATOR */
@@ -0,0 +1,366 @@
+/**
+ * @file CVODESIntegrator.h
+ * @brief Header-only CVODES integrator with the model type as a template parameter
+ * @details
+ *  CVODESSerialIntegrator reaches the model through Utility: the static CVODES
+ *  callback makes a virtual call into the adapter, which calls the reactor. Here
+ *  the callbacks are instantiated per model type and call the model directly,
+ *  so the RHS and Jacobian can be inlined into them (across translation units
+ *  with -flto, see compile.sh).
+ *
+ *  The model only has to satisfy @ref ODEModel; the analytic Jacobian is used
+ *  when it also satisfies @ref ODEModelWithJacobian, otherwise CVODES builds a
+ *  difference-quotient Jacobian. Both IdealGasConstPressureAdiabaticReactor and
+ *  Reactor<NSpecies> can be used directly, without an adapter.
+ *
+ *  The session is BDF with a dense linear solver and scalar tolerances from
+ *  ChemConfig. Sensitivities, events, sparse solvers and method
+ *  switching stay on the Utility path (CVODESSerialIntegrator).
+ */
+
+#ifndef SRC_INTEGRATOR_CVODES_INTEGRATOR
+#define SRC_INTEGRATOR_CVODES_INTEGRATOR
+
+#include <iostream>
+#include <concepts>
+#include <type_traits>
+
+/** @name SUNDIALS includes
+ *  @{ */
+#include <cvodes/cvodes.h>          						                    /*!< Prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h> 						                    /*!< Access to serial N_Vector            */
+#include <sunlinsol/sunlinsol_dense.h> 						                    /*!< Access to dense SUNLinearSolver      */
+#include <sunmatrix/sunmatrix_dense.h> 						                    /*!< Access to dense SUNMatrix            */
+/** @} */
+
+#include "Utility.h"                                                            /*!< Runtime hasJacobian() check for Utility models. */
+#include "SUNDIALSHelpers.h"
+#include "ChemConfig.h"
+
+
+/**
+ * @brief Minimal model interface: size, initial state and RHS, state layout of the model's choice.
+ */
+template<typename M>
+concept ODEModel = requires(M m, double t, double *y, double *ydot)
+{
+    { m.setNEQ() } -> std::convertible_to<int>;
+    m.setInitialState(y);
+    m.evalRHS(t, y, ydot);
+};
+
+
+/**
+ * @brief Model that also provides a dense, column-major NEQ×NEQ Jacobian.
+ */
+template<typename M>
+concept ODEModelWithJacobian = ODEModel<M> && requires(M m, double t, double *y, double *ydot, double *J)
+{
+    m.evalJacobian(t, y, ydot, J);
+};
+
+
+/**
+ * @class CVODESIntegrator
+ * @brief BDF / dense CVODES session whose callbacks call @p Model without virtual dispatch.
+ * @tparam Model Model type satisfying @ref ODEModel.
+ * @details
+ *  Usage:
+ *      1. Construct with the model (must outlive the integrator).
+ *      2. initializeandsetupsolver().
+ *      3. advance(dt), or reset(t0, y0) then advance(dt) per cell.
+ *      4. freeMemory().
+ */
+template<ODEModel Model>
+class CVODESIntegrator
+{
+    public:
+        /**
+         * @brief Construct the integrator around a model.
+         * @param[in] model Model instance (non-owning).
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         */
+        explicit CVODESIntegrator (Model &model, int debug = 0);
+
+        /**
+         * @brief Create the SUNDIALS context, state, session and dense solver.
+         * @return 0 on success, 1 on failure.
+         */
+        int initializeandsetupsolver();
+
+        /**
+         * @brief Restart the session from a new initial condition, keeping all SUNDIALS objects.
+         * @param[in] t0 Initial time [s].
+         * @param[in] y0 Initial state (length = NEQ).
+         */
+        void reset(double t0, const double *y0);
+
+        /**
+         * @brief Integrate from the current time by @p dt, stopping exactly at t + dt.
+         * @param[in] dt Time step [s].
+         * @return CVode() flag (negative on failure).
+         */
+        int advance(double dt);
+
+        /**
+         * @brief Copy the current state vector.
+         * @param[out] y State (length = NEQ).
+         */
+        void getState(double *y);
+
+        /**
+         * @brief Release all allocated SUNDIALS resources.
+         */
+        void freeMemory();
+
+        /* Debugger, getter fns */
+        int    getNEQ();
+        double getTime();
+        long   getNumberofSteps();
+        long   getNumberofRHSEvals();
+
+
+    private:
+        Model          &model_;                                                 /*!< Model (non-owning).                 */
+
+        int             NEQ_;                                                   /*!< Number of equations.                */
+        double          RTOL_;                                                  /*!< Relative tolerance (scalar).        */
+        double          ATOL_;                                                  /*!< Absolute tolerance (all equations). */
+        double          time_;                                                  /*!< Current time [s].                   */
+
+        SUNContext      sunctx_;                                                /*!< SUNDIALS context.                   */
+        void           *cvode_mem_;                                             /*!< CVODES session handle.              */
+        N_Vector        y_;                                                     /*!< State.                              */
+        N_Vector        abstol_;                                                /*!< Absolute tolerances.                */
+        SUNMatrix       A_;                                                     /*!< Dense Jacobian.                     */
+        SUNLinearSolver LS_;                                                    /*!< Dense linear solver.                */
+
+        int debug_;
+
+        /**
+         * @brief Whether the analytic Jacobian is attached.
+         */
+        bool useJacobian();
+
+        /* CVODES callbacks, user_data is the Model; instantiated per model type */
+        static int cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data);
+        static int cvode_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+};
+
+
+/* ------------------------------------------------------------------------------------------------
+ * Definitions (header-only: instantiated per model type)
+ * ------------------------------------------------------------------------------------------------ */
+
+template<ODEModel Model>
+int CVODESIntegrator<Model>::cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data)
+{
+    static_cast<Model*>(user_data)->evalRHS(t, N_VGetArrayPointer(y), N_VGetArrayPointer(ydot));
+
+    return 0;
+}
+
+
+template<ODEModel Model>
+int CVODESIntegrator<Model>::cvode_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                                       N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    if constexpr (ODEModelWithJacobian<Model>)
+    {
+        static_cast<Model*>(user_data)->evalJacobian(t, N_VGetArrayPointer(y), N_VGetArrayPointer(fy),
+                                                     SUNDenseMatrix_Data(J));
+    }
+
+    return 0;
+}
+
+
+template<ODEModel Model>
+CVODESIntegrator<Model>::CVODESIntegrator(Model &model, int debug) : model_(model)
+{
+    NEQ_       = model_.setNEQ();
+    RTOL_      = ChemConfig::RTOL;
+    ATOL_      = ChemConfig::ATOL;
+    time_      = 0.0;
+
+    sunctx_    = nullptr;
+    cvode_mem_ = nullptr;
+    y_         = nullptr;
+    abstol_    = nullptr;
+    A_         = nullptr;
+    LS_        = nullptr;
+    debug_     = debug;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Constructor of templated CVODES integrator implemented! NEQ: "<<NEQ_<<std::endl;
+    }
+}
+
+
+template<ODEModel Model>
+bool CVODESIntegrator<Model>::useJacobian()
+{
+    if constexpr (!ODEModelWithJacobian<Model>)
+    {
+        return false;
+    }
+    else if constexpr (std::is_base_of_v<Utility, Model>)
+    {
+        return model_.hasJacobian();                                            /* Utility::evalJacobian() is a no-op by default */
+    }
+    else
+    {
+        return true;
+    }
+}
+
+
+template<ODEModel Model>
+int CVODESIntegrator<Model>::initializeandsetupsolver()
+{
+    int flag;
+
+    flag = SUNContext_Create(SUN_COMM_NULL, &sunctx_);
+    if(check_retval(&flag, "SUNContext_Create", 1)) return (1);
+
+    y_      = N_VNew_Serial(NEQ_, sunctx_);
+    abstol_ = N_VNew_Serial(NEQ_, sunctx_);
+    if(check_retval((void*)y_, "N_VNew_Serial", 0) || check_retval((void*)abstol_, "N_VNew_Serial", 0))
+    {
+        return (1);
+    }
+
+    model_.setInitialState(N_VGetArrayPointer(y_));
+    N_VConst(ATOL_, abstol_);
+
+    cvode_mem_ = CVodeCreate(CV_BDF, sunctx_);
+    if(check_retval(cvode_mem_, "CVodeCreate", 0)) return (1);
+
+    flag = CVodeInit(cvode_mem_, cvode_rhs, time_, y_);
+    if(check_retval(&flag, "CVodeInit", 1)) return (1);
+
+    flag = CVodeSetUserData(cvode_mem_, &model_);
+    if(check_retval(&flag, "CVodeSetUserData", 1)) return (1);
+
+    flag = CVodeSVtolerances(cvode_mem_, RTOL_, abstol_);
+    if(check_retval(&flag, "CVodeSVtolerances", 1)) return (1);
+
+    A_  = SUNDenseMatrix(NEQ_, NEQ_, sunctx_);
+    LS_ = SUNLinSol_Dense(y_, A_, sunctx_);
+    if(check_retval((void*)A_, "SUNDenseMatrix", 0) || check_retval((void*)LS_, "SUNLinSol_Dense", 0))
+    {
+        return (1);
+    }
+
+    flag = CVodeSetLinearSolver(cvode_mem_, LS_, A_);
+    if(check_retval(&flag, "CVodeSetLinearSolver", 1)) return (1);
+
+    if(useJacobian())
+    {
+        flag = CVodeSetJacFn(cvode_mem_, cvode_jac);
+        if(check_retval(&flag, "CVodeSetJacFn", 1)) return (1);
+    }
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Initialized and setup templated solver! Analytic Jacobian: "<<useJacobian()<<std::endl;
+    }
+
+    return (0);
+}
+
+
+template<ODEModel Model>
+void CVODESIntegrator<Model>::reset(double t0, const double *y0)
+{
+    double *ydata = N_VGetArrayPointer(y_);
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        ydata[i] = y0[i];
+    }
+    time_ = t0;
+
+    int flag = CVodeReInit(cvode_mem_, t0, y_);
+    check_retval(&flag, "CVodeReInit", 1);
+}
+
+
+template<ODEModel Model>
+int CVODESIntegrator<Model>::advance(double dt)
+{
+    double tout = time_ + dt;
+
+    CVodeSetStopTime(cvode_mem_, tout);
+    int flag = CVode(cvode_mem_, tout, y_, &time_, CV_NORMAL);
+    check_retval(&flag, "CVode", 1);
+
+    return flag;
+}
+
+
+template<ODEModel Model>
+void CVODESIntegrator<Model>::getState(double *y)
+{
+    double *ydata = N_VGetArrayPointer(y_);
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        y[i] = ydata[i];
+    }
+}
+
+
+template<ODEModel Model>
+void CVODESIntegrator<Model>::freeMemory()
+{
+    N_VDestroy(y_);
+    N_VDestroy(abstol_);
+    CVodeFree(&cvode_mem_);
+    SUNLinSolFree(LS_);
+    SUNMatDestroy(A_);
+    SUNContext_Free(&sunctx_);
+
+    y_      = nullptr;
+    abstol_ = nullptr;
+    LS_     = nullptr;
+    A_      = nullptr;
+}
+
+
+/* Debugger, getter fns */
+template<ODEModel Model>
+int CVODESIntegrator<Model>::getNEQ()
+{
+    return NEQ_;
+}
+
+
+template<ODEModel Model>
+double CVODESIntegrator<Model>::getTime()
+{
+    return time_;
+}
+
+
+template<ODEModel Model>
+long CVODESIntegrator<Model>::getNumberofSteps()
+{
+    long nsteps = 0;
+    CVodeGetNumSteps(cvode_mem_, &nsteps);
+    return nsteps;
+}
+
+
+template<ODEModel Model>
+long CVODESIntegrator<Model>::getNumberofRHSEvals()
+{
+    long nrhs = 0;
+    CVodeGetNumRhsEvals(cvode_mem_, &nrhs);
+    return nrhs;
+}
+
+
+#endif /* SRC_INTEGRATOR_CVODES_INTEGRATOR */
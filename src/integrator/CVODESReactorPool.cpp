@@ -0,0 +1,268 @@
+#include "CVODESReactorPool.h"
+#include "SUNDIALSHelpers.h"
+#include "ChemConfig.h"
+
+
+CVODESReactorPool::CVODESReactorPool(std::vector<Utility*> workerModels, int debug)
+{
+    NEQ_        = workerModels.empty() ? 0 : workerModels[0]->setNEQ();
+    RTOL_       = ChemConfig::RTOL * (workerModels.empty() ? 1.0 : workerModels[0]->getToleranceScale());
+    ATOL_       = ChemConfig::ATOL * (workerModels.empty() ? 1.0 : workerModels[0]->getToleranceScale());
+
+    generation_ = 0;
+    active_     = 0;
+    nfailed_    = 0;
+    stop_       = false;
+    started_    = false;
+    cells_      = nullptr;
+    dt_         = 0.0;
+    debug_      = debug;
+
+    for(Utility *m : workerModels)
+    {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->model = m;
+    }
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Constructor of CVODES reactor pool implemented! Workers: "<<workers_.size()<<std::endl;
+    }
+}
+
+
+CVODESReactorPool::~CVODESReactorPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+
+    for(auto &w : workers_)
+    {
+        if(w->thread.joinable())
+        {
+            w->thread.join();
+        }
+    }
+}
+
+
+int CVODESReactorPool::setupWorker(Worker &w)
+{
+    SUNContext_Create(SUN_COMM_NULL, &w.sunctx);                                /* SUNContext is not shared across threads */
+
+    return setupDenseSession(w, w.model, NEQ_, 0.0, RTOL_, ATOL_, w.sunctx);
+}
+
+
+bool CVODESReactorPool::popTask(int id, int &cell)
+{
+    /* Own deque: LIFO end */
+    {
+        Worker &w = *workers_[id];
+        std::lock_guard<std::mutex> lock(w.tasks_mutex);
+        if(!w.tasks.empty())
+        {
+            cell = w.tasks.back();
+            w.tasks.pop_back();
+            return true;
+        }
+    }
+
+    /* Steal from the FIFO end of the others, starting at the next neighbour */
+    int nworkers = workers_.size();
+    for(int k = 1; k < nworkers; k++)
+    {
+        Worker &victim = *workers_[(id + k) % nworkers];
+        std::lock_guard<std::mutex> lock(victim.tasks_mutex);
+        if(!victim.tasks.empty())
+        {
+            cell = victim.tasks.front();
+            victim.tasks.pop_front();
+            workers_[id]->nsteals++;
+            return true;
+        }
+    }
+
+    return false;                                                               /* No tasks are added mid-generation, so all done */
+}
+
+
+int CVODESReactorPool::integrateCell(Worker &w, ReactorCell &cell)
+{
+    int     flag;
+    double  time  = 0.0;
+    double *ydata = N_VGetArrayPointer(w.y);
+
+    w.model->setCellState(cell.temperature, cell.pressure, cell.Y);
+    w.model->setInitialState(ydata);
+
+    flag = CVodeReInit(w.cvode_mem, 0.0, w.y);                                  /* Reuse the session, no reallocation */
+    if(check_retval(&flag, "CVodeReInit", 1)) return (1);
+
+    CVodeSetStopTime(w.cvode_mem, dt_);
+    flag = CVode(w.cvode_mem, dt_, w.y, &time, CV_NORMAL);
+    if(check_retval(&flag, "CVode", 1))
+    {
+        return (1);                                                             /* Leave the cell untouched */
+    }
+
+    /* Write back: layout [T, Y1..Y_N] */
+    cell.temperature = ydata[0];
+    for(int i = 1; i < NEQ_; i++)
+    {
+        cell.Y[i - 1] = ydata[i];
+    }
+
+    return (0);
+}
+
+
+void CVODESReactorPool::workerLoop(int id)
+{
+    Worker &w    = *workers_[id];
+    long    seen = 0;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex_);
+            start_cv_.wait(lock, [&]{ return stop_ || generation_ != seen; });
+            if(stop_)
+            {
+                return;
+            }
+            seen = generation_;
+        }
+
+        int cell;
+        int nfailed = 0;
+        while(popTask(id, cell))
+        {
+            nfailed += integrateCell(w, (*cells_)[cell]);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            nfailed_ += nfailed;
+            if(--active_ == 0)
+            {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+
+/* Public functions */
+int CVODESReactorPool::initializeandsetupsolver()
+{
+    for(size_t id = 0; id < workers_.size(); id++)
+    {
+        if(setupWorker(*workers_[id]))
+        {
+            std::cout<<"--Setup of pool worker "<<id<<" failed, pool not started!"<<std::endl;
+            freeMemory();                                                       /* No thread is running yet */
+            return (1);
+        }
+    }
+
+    for(size_t id = 0; id < workers_.size(); id++)
+    {
+        workers_[id]->thread = std::thread(&CVODESReactorPool::workerLoop, this, id);
+    }
+    started_ = true;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Initialized and setup reactor pool!"<<std::endl;
+    }
+
+    return (0);
+}
+
+
+int CVODESReactorPool::advance(std::vector<ReactorCell> &cells, double dt)
+{
+    int nworkers = workers_.size();
+    int ncells   = cells.size();
+
+    if(!started_)
+    {
+        std::cout<<"--Reactor pool is not running, no cell advanced!"<<std::endl;
+        return ncells;
+    }
+
+    /* Deal contiguous chunks so that neighbouring cells stay on one worker until stolen */
+    for(int id = 0; id < nworkers; id++)
+    {
+        Worker &w     = *workers_[id];
+        int     begin = (long)ncells * id / nworkers;
+        int     end   = (long)ncells * (id + 1) / nworkers;
+
+        std::lock_guard<std::mutex> lock(w.tasks_mutex);
+        for(int c = end - 1; c >= begin; c--)
+        {
+            w.tasks.push_back(c);                                               /* Reversed so the owner pops in cell order */
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(pool_mutex_);
+    cells_   = &cells;
+    dt_      = dt;
+    nfailed_ = 0;
+    active_  = nworkers;
+    generation_++;
+    start_cv_.notify_all();
+
+    done_cv_.wait(lock, [&]{ return active_ == 0; });
+    cells_ = nullptr;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Pool advanced "<<ncells<<" cells, steals so far: "<<getNumberofSteals()<<std::endl;
+    }
+
+    return nfailed_;
+}
+
+
+void CVODESReactorPool::freeMemory()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+
+    for(auto &w : workers_)
+    {
+        if(w->thread.joinable())
+        {
+            w->thread.join();
+        }
+        freeDenseSession(*w);                                                   /* Safe to call freeMemory() again */
+        SUNContext_Free(&w->sunctx);
+    }
+    started_ = false;
+}
+
+
+/* Debugger, getter fns */
+int CVODESReactorPool::getNumberofWorkers()
+{
+    return workers_.size();
+}
+
+
+long CVODESReactorPool::getNumberofSteals()
+{
+    long nsteals = 0;
+    for(auto &w : workers_)
+    {
+        nsteals += w->nsteals;
+    }
+    return nsteals;
+}
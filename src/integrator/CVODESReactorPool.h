@@ -0,0 +1,157 @@
+/**
+ * @file CVODESReactorPool.h
+ * @brief Multithreaded driver that advances many reactor cells with work stealing
+ * @details
+ *  Each worker thread owns one model (its reactor scratch), one SUNContext and one
+ *  CVODES session that is re-initialized for every cell it picks up. Cells are
+ *  dealt out in contiguous chunks to per-worker deques; a worker pops from the
+ *  back of its own deque and, once empty, steals from the front of the others.
+ *  Igniting cells can cost orders of magnitude more than inert ones, so idle
+ *  workers keep draining the busy workers' queues instead of waiting.
+ */
+
+#ifndef SRC_INTEGRATOR_CVODES_REACTOR_POOL
+#define SRC_INTEGRATOR_CVODES_REACTOR_POOL
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "SUNDIALSHelpers.h"                                                    /*!< Dense BDF session, CVODES trampolines, check_retval() */
+
+
+/**
+ * @brief Thermochemical state of one CFD cell, updated in place by the pool.
+ * @note @ref Y points into caller storage (e.g. the flow solver's species arrays).
+ */
+struct ReactorCell
+{
+    double  temperature;                                                        /*!< Temperature [K].                       */
+    double  pressure;                                                           /*!< Pressure [Pa].                         */
+    double *Y;                                                                  /*!< Mass fractions (non-owning, length N). */
+};
+
+
+/**
+ * @class CVODESReactorPool
+ * @brief Thread pool of reusable CVODES sessions for operator-split chemistry.
+ * @details
+ *  Usage:
+ *      1. Construct with one Utility model per worker; models must implement
+ *         @ref Utility::setCellState() and use the [T, Y1..Y_N] state layout.
+ *      2. initializeandsetupsolver() creates the sessions and starts the threads.
+ *      3. advance(cells, dt) once per CFD step.
+ *      4. freeMemory() joins the threads and releases SUNDIALS resources.
+ */
+class CVODESReactorPool
+{
+    public:
+        /**
+         * @brief Construct a pool with one worker per model.
+         * @param[in] workerModels One model per worker thread (non-owning, not shared).
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         */
+        explicit CVODESReactorPool (std::vector<Utility*> workerModels, int debug = 0);
+
+        /**
+         * @brief Joins the worker threads if freeMemory() was not called.
+         */
+        ~CVODESReactorPool();
+
+        /**
+         * @brief Create one CVODES session per worker and start the threads.
+         * @return 0 on success; 1 if any session failed, in which case nothing is
+         *         started and every session already created is released.
+         */
+        int initializeandsetupsolver();
+
+        /**
+         * @brief Advance every cell by @p dt, in place.
+         * @param[in,out] cells Cell states; each is integrated from t = 0 to t = dt.
+         * @param[in] dt Time step [s].
+         * @return Number of cells whose integration failed (flag < 0); all of them
+         *         if the pool is not running.
+         */
+        int advance(std::vector<ReactorCell> &cells, double dt);
+
+        /**
+         * @brief Stop the worker threads and release all SUNDIALS resources.
+         * @note Idempotent; the pool cannot be restarted afterwards.
+         */
+        void freeMemory();
+
+        /* Debugger, getter fns */
+        int  getNumberofWorkers();
+        long getNumberofSteals();                                               /*!< Cells taken from another worker's deque, summed over all advance() calls. */
+
+
+    private:
+
+        /**
+         * @brief Per-thread state: reactor scratch, CVODES session and task deque.
+         */
+        struct Worker : DenseCVODESSession                                      /* Session reused for every cell */
+        {
+            Utility        *model     = nullptr;                                /*!< Worker's own model (non-owning). */
+            SUNContext      sunctx    = nullptr;                                /*!< Per-thread SUNDIALS context.     */
+
+            std::deque<int> tasks;                                              /*!< Cell indices still to integrate. */
+            std::mutex      tasks_mutex;                                        /*!< Guards @ref tasks.               */
+            std::thread     thread;                                             /*!< Worker thread.                   */
+            long            nsteals   = 0;                                      /*!< Cells stolen from other workers. */
+        };
+
+        int    NEQ_;                                                            /*!< Equations per cell.                 */
+        double RTOL_;                                                           /*!< Relative tolerance (scalar).        */
+        double ATOL_;                                                           /*!< Absolute tolerance (all equations). */
+
+        std::vector<std::unique_ptr<Worker>> workers_;                          /*!< Workers (non-movable, hence unique_ptr). */
+
+        /* Dispatch state, guarded by pool_mutex_ */
+        std::mutex              pool_mutex_;
+        std::condition_variable start_cv_;                                      /*!< Signals a new generation or stop.   */
+        std::condition_variable done_cv_;                                       /*!< Signals all workers finished.       */
+        long                    generation_;                                    /*!< Incremented once per advance().     */
+        int                     active_;                                        /*!< Workers still draining tasks.       */
+        int                     nfailed_;                                       /*!< Failed cells in this generation.    */
+        bool                    stop_;                                          /*!< Tells workers to exit.              */
+        bool                    started_;                                       /*!< Threads running, sessions valid.    */
+
+        std::vector<ReactorCell> *cells_;                                       /*!< Cells of the current advance().     */
+        double                    dt_;                                          /*!< Step of the current advance().      */
+
+        int debug_;
+
+        /**
+         * @brief Create the CVODES session of one worker.
+         * @return 0 on success, non-zero on failure.
+         */
+        int setupWorker(Worker &w);
+
+        /**
+         * @brief Thread body: wait for a generation, drain tasks, report back.
+         * @param[in] id Worker index.
+         */
+        void workerLoop(int id);
+
+        /**
+         * @brief Take the next cell: back of own deque first, then steal from others' fronts.
+         * @param[in] id Worker index.
+         * @param[out] cell Cell index.
+         * @return false when every deque is empty.
+         */
+        bool popTask(int id, int &cell);
+
+        /**
+         * @brief Load a cell into the worker's session, integrate over dt_ and write back.
+         * @return 0 on success, 1 on failure.
+         */
+        int integrateCell(Worker &w, ReactorCell &cell);
+};
+
+
+#endif /* SRC_INTEGRATOR_CVODES_REACTOR_POOL */
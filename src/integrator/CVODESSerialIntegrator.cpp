@@ -1,82 +1,299 @@
 #include "CVODESSerialIntegrator.h"
+#include "ChemConfig.h"
+#include "SUNDIALSHelpers.h"
 
+#include <algorithm>
+#include <cmath>
 
-static int cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data)
+
+static void PrintOutput(sunrealtype t, sunrealtype y1, sunrealtype y2,
+                        sunrealtype y3)
+{
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("At t = %0.4Le      y =%14.6Le  %14.6Le  %14.6Le\n", t, y1, y2, y3);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf("At t = %0.4e      y =%14.6e  %14.6e  %14.6e\n", t, y1, y2, y3);
+#else
+  printf("At t = %0.4e      y =%14.6e  %14.6e  %14.6e\n", t, y1, y2, y3);
+#endif
+
+  return;
+}
+
+
+static void PrintAllOutput(sunrealtype t, N_Vector y, int NEQ)
+{
+    printf("At t = %0.4e"); 
+    double *ydata = N_VGetArrayPointer(y);
+
+    for(int i = 0; i < NEQ; i++)
+    {
+        std::cout<<std::endl;
+        std::cout<<">"<<ydata[i];
+    }
+    std::cout<<std::endl;
+  return;
+}
+
+
+int CVODESSerialIntegrator::cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data)
 {
-    Utility *f = static_cast<Utility*>(user_data);
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
 
     double *ydata    = N_VGetArrayPointer(y);
     double *ydotdata = N_VGetArrayPointer(ydot);
 
-    f->evalRHS(t, ydata, ydotdata);
+    integ->model_.evalRHS(t, ydata, ydotdata);
+
+    return 0;
+}
+
+
+int CVODESSerialIntegrator::cvode_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                                      N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+
+    double *ydata  = N_VGetArrayPointer(y);
+    double *fydata = N_VGetArrayPointer(fy);
+
+    integ->model_.evalJacobian(t, ydata, fydata, SUNDenseMatrix_Data(J));      /* Dense storage is column-major, ldim = NEQ */
+
+    return 0;
+}
+
+
+int CVODESSerialIntegrator::cvode_sparse_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                                             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+
+    double *ydata  = N_VGetArrayPointer(y);
+    double *fydata = N_VGetArrayPointer(fy);
+
+    /* SUNMatZero() clears the index arrays too, so the pattern is rewritten on every call */
+    std::copy(integ->Jcolptrs_.begin(), integ->Jcolptrs_.end(), SUNSparseMatrix_IndexPointers(J));
+    std::copy(integ->Jrowvals_.begin(), integ->Jrowvals_.end(), SUNSparseMatrix_IndexValues(J));
+
+    integ->model_.evalSparseJacobian(t, ydata, fydata, SUNSparseMatrix_Data(J));
 
     return 0;
 }
 
 
-static int check_retval(void* returnvalue, const char* funcname, int opt)
+int CVODESSerialIntegrator::cvode_linsys(double t, N_Vector y, N_Vector fy, SUNMatrix A, sunbooleantype jok,
+                                         sunbooleantype *jcur, double gamma, void* user_data,
+                                         N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+
+    double *ydata = N_VGetArrayPointer(y);
+    SUNMatrix J   = integ->Jlast_;
+
+    if(jok)
+    {
+        *jcur = SUNFALSE;                                                       /* CVODES asks to keep the last J */
+    }
+    else if(integ->reuseJacobian(J, ydata, false))
+    {
+        *jcur = SUNFALSE;                                                       /* Another cell's J: stale, so a Newton failure
+                                                                                   re-evaluates it instead of cutting the step */
+    }
+    else
+    {
+        int flag = (integ->linsol_ == LinearSolverType::Sparse)
+                 ? cvode_sparse_jac(t, y, fy, J, user_data, tmp1, tmp2, tmp3)
+                 : cvode_jac(t, y, fy, J, user_data, tmp1, tmp2, tmp3);
+        if(flag != 0)
+        {
+            return flag;
+        }
+        integ->reuseJacobian(J, ydata, true);
+        *jcur = SUNTRUE;
+    }
+
+    /* A = I - gamma * J */
+    SUNMatCopy(J, A);
+    return SUNMatScaleAddI(-gamma, A);
+}
+
+
+int CVODESSerialIntegrator::cvode_psetup(double t, N_Vector y, N_Vector fy, sunbooleantype jok,
+                                         sunbooleantype *jcurPtr, double gamma, void* user_data)
 {
-  int* retval;
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+    int n = integ->NEQ_;
 
-  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
-  if (opt == 0 && returnvalue == NULL)
-  {
-    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
-            funcname);
-    return (1);
-  }
+    if(jok)
+    {
+        *jcurPtr = SUNFALSE;                                                    /* Reuse the saved arrowhead */
+    }
+    else
+    {
+        integ->model_.evalJacobianArrowhead(t, N_VGetArrayPointer(y), N_VGetArrayPointer(fy),
+                                            integ->Pdiag_.data(), integ->Prow_.data(), integ->Pcol_.data());
+        *jcurPtr = SUNTRUE;
+    }
 
-  /* Check if retval < 0 */
-  else if (opt == 1)
-  {
-    retval = (int*)returnvalue;
-    if (*retval < 0)
+    /* M = I - gamma*J on the arrowhead: [m00 r^T; c D]. Eliminate the diagonal
+     * species block D to get the scalar Schur complement m00 - r^T D^{-1} c. */
+    double schur = 1.0 - gamma * integ->Pdiag_[0];
+    for(int i = 1; i < n; i++)
+    {
+        integ->Mdiag_[i] = 1.0 - gamma * integ->Pdiag_[i];
+        if(integ->Mdiag_[i] == 0.0)
+        {
+            return 1;                                                           /* Recoverable: CVODES retries with a smaller step */
+        }
+        schur -= (gamma * integ->Prow_[i]) * (gamma * integ->Pcol_[i]) / integ->Mdiag_[i];
+    }
+    if(schur == 0.0)
     {
-      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
-              funcname, *retval);
-      return (1);
+        return 1;
     }
-  }
 
-  /* Check if function returned NULL pointer - no memory allocated */
-  else if (opt == 2 && returnvalue == NULL)
-  {
-    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
-            funcname);
-    return (1);
-  }
+    integ->Mschur_ = schur;
+    integ->Mgamma_ = gamma;
 
-  return (0);
+    return 0;
 }
 
 
-static void PrintOutput(sunrealtype t, sunrealtype y1, sunrealtype y2,
-                        sunrealtype y3)
+int CVODESSerialIntegrator::cvode_psolve(double t, N_Vector y, N_Vector fy, N_Vector r, N_Vector z,
+                                         double gamma, double delta, int lr, void* user_data)
 {
-#if defined(SUNDIALS_EXTENDED_PRECISION)
-  printf("At t = %0.4Le      y =%14.6Le  %14.6Le  %14.6Le\n", t, y1, y2, y3);
-#elif defined(SUNDIALS_DOUBLE_PRECISION)
-  printf("At t = %0.4e      y =%14.6e  %14.6e  %14.6e\n", t, y1, y2, y3);
-#else
-  printf("At t = %0.4e      y =%14.6e  %14.6e  %14.6e\n", t, y1, y2, y3);
-#endif
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+    int     n     = integ->NEQ_;
+    double  g     = integ->Mgamma_;
+    double *rdata = N_VGetArrayPointer(r);
+    double *zdata = N_VGetArrayPointer(z);
+
+    /* z0 = (r0 - sum_i m0i r_i / D_i) / schur, with m0i = -g*row_i */
+    double rhs0 = rdata[0];
+    for(int i = 1; i < n; i++)
+    {
+        rhs0 += g * integ->Prow_[i] * rdata[i] / integ->Mdiag_[i];
+    }
+    zdata[0] = rhs0 / integ->Mschur_;
 
-  return;
+    /* z_i = (r_i - mi0 z0) / D_i, with mi0 = -g*col_i */
+    for(int i = 1; i < n; i++)
+    {
+        zdata[i] = (rdata[i] + g * integ->Pcol_[i] * zdata[0]) / integ->Mdiag_[i];
+    }
+
+    return 0;
 }
 
 
-static void PrintAllOutput(sunrealtype t, N_Vector y, int NEQ)
+int CVODESSerialIntegrator::cvode_root(double t, N_Vector y, double *gout, void* user_data)
 {
-    printf("At t = %0.4e"); 
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+    int     n     = integ->NEQ_;
     double *ydata = N_VGetArrayPointer(y);
+    double *ydot  = integ->event_ydot_.data();
+    double *yddot = integ->event_yddot_.data();
 
-    for(int i = 0; i < NEQ; i++)
+    integ->model_.evalRHS(t, ydata, ydot);
+
+    /* d(ydot)/dt = J*ydot for an autonomous model, by one directional difference */
+    if(integ->event_needs_yddot_)
     {
-        std::cout<<std::endl;
-        std::cout<<">"<<ydata[i];
+        double ynorm = 0.0;
+        double fnorm = 0.0;
+        for(int i = 0; i < n; i++)
+        {
+            ynorm += ydata[i] * ydata[i];
+            fnorm += ydot[i] * ydot[i];
+        }
+        ynorm = std::sqrt(ynorm);
+        fnorm = std::sqrt(fnorm);
+
+        if(fnorm > 0.0)
+        {
+            double  sigma = 1.0e-7 * (ynorm + 1.0) / fnorm;
+            double *ytmp  = integ->event_ytmp_.data();
+            for(int i = 0; i < n; i++)
+            {
+                ytmp[i] = ydata[i] + sigma * ydot[i];
+            }
+            integ->model_.evalRHS(t + sigma, ytmp, yddot);
+            for(int i = 0; i < n; i++)
+            {
+                yddot[i] = (yddot[i] - ydot[i]) / sigma;
+            }
+        }
+        else
+        {
+            std::fill(integ->event_yddot_.begin(), integ->event_yddot_.end(), 0.0);
+        }
     }
-    std::cout<<std::endl;
-  return;
+
+    for(size_t k = 0; k < integ->events_.size(); k++)
+    {
+        gout[k] = integ->events_[k].g(t, ydata, ydot, yddot);
+    }
+
+    return 0;
+}
+
+
+int CVODESSerialIntegrator::cvode_sens_rhs(int Ns, double t, N_Vector y, N_Vector ydot, N_Vector *yS,
+                                           N_Vector *ySdot, void* user_data, N_Vector tmp1, N_Vector tmp2)
+{
+    CVODESSerialIntegrator *integ = static_cast<CVODESSerialIntegrator*>(user_data);
+    int     n     = integ->NEQ_;
+    double *ydata = N_VGetArrayPointer(y);
+    double *fdata = N_VGetArrayPointer(ydot);
+    double *ytmp  = N_VGetArrayPointer(tmp1);
+    double *ftmp  = N_VGetArrayPointer(tmp2);
+
+    double ynorm = 0.0;
+    for(int i = 0; i < n; i++)
+    {
+        ynorm += ydata[i] * ydata[i];
+    }
+    ynorm = std::sqrt(ynorm);
+
+    for(int k = 0; k < Ns; k++)
+    {
+        double *sdata  = N_VGetArrayPointer(yS[k]);
+        double *sddata = N_VGetArrayPointer(ySdot[k]);
+
+        /* J*s_k by one directional difference, as for yddot in cvode_root() */
+        double snorm = 0.0;
+        for(int i = 0; i < n; i++)
+        {
+            snorm += sdata[i] * sdata[i];
+        }
+        snorm = std::sqrt(snorm);
+
+        if(snorm > 0.0)
+        {
+            double sigma = 1.0e-7 * (ynorm + 1.0) / snorm;
+            for(int i = 0; i < n; i++)
+            {
+                ytmp[i] = ydata[i] + sigma * sdata[i];
+            }
+            integ->model_.evalRHS(t, ytmp, ftmp);
+            for(int i = 0; i < n; i++)
+            {
+                ftmp[i] = (ftmp[i] - fdata[i]) / sigma;
+            }
+        }
+        else
+        {
+            std::fill(ftmp, ftmp + n, 0.0);
+        }
+
+        integ->model_.evalParameterDerivative(t, ydata, fdata, k, sddata);
+        for(int i = 0; i < n; i++)
+        {
+            sddata[i] += ftmp[i];
+        }
+    }
+
+    return 0;
 }
 
 
@@ -85,20 +302,49 @@ CVODESSerialIntegrator::CVODESSerialIntegrator(Utility &model, int debug) : mode
 {
     cvode_mem_  = nullptr;                        
     abstol_     = nullptr;
-    RTOL_       = 1.0e-8;
+    RTOL_       = 1.0e-8 * model.getToleranceScale();
     ATOL_.resize(NEQ_);
     for(int i = 0; i < NEQ_; i++)
     {
-        ATOL_[i] = 1e-8;
+        ATOL_[i] = 1e-8 * model.getToleranceScale();
     }
     y_          = nullptr;
+    ysample_    = nullptr;
     A_          = nullptr;
     LS_         = nullptr;
+    linsol_     = LinearSolverType::Dense;
+    FID_        = nullptr;
+    Jsaved_     = nullptr;
+    Jlast_      = nullptr;
+    Mschur_     = 1.0;
+    event_needs_yddot_ = false;
+    sens_method_ = 0;
+    Ns_          = 0;
+    yS_          = nullptr;
+    method_      = IntegrationMethod::Automatic;
+    lmm_         = CV_BDF;
+    NLS_         = nullptr;
+    nswitches_   = 0;
+    steps_since_check_ = 0;
+    tstop_       = 0.0;
+    has_tstop_   = false;
+    Mgamma_     = 0.0;
+    carry_step_     = false;
+    carry_jacobian_ = false;
+    jac_saved_      = false;
+    use_saved_jac_  = false;
+    jac_msbp_        = 0;
+    jac_msbj_        = 0;
+    jac_dgmax_       = 0.0;
+    jac_cache_size_  = 0;
+    jac_cache_rtol_  = ChemConfig::JAC_CACHE_RTOL;
+    jac_cache_hit_   = -1;
+    jac_cache_store_ = false;
+    jac_cache_clock_ = 0;
+    jac_cache_hits_  = 0;
 
     time0_      = 0.0;
-    timeop_     = 1.0;                                                          /* Hardcoded */
-    TMULT_      = 10.0;                                                         /* Hardcoded */
-    steps_      = 12;
+    schedule_   = OutputSchedule::logarithmic(1.0, 1.0e11, 12);                 /* Default: one output per decade */
 
     debug_      = debug;
 
@@ -109,6 +355,18 @@ CVODESSerialIntegrator::CVODESSerialIntegrator(Utility &model, int debug) : mode
 } 
 
 
+void CVODESSerialIntegrator::setLinearSolverType(LinearSolverType type)
+{
+    linsol_ = type;
+}
+
+
+void CVODESSerialIntegrator::setIntegrationMethod(IntegrationMethod method)
+{
+    method_ = method;
+}
+
+
 int CVODESSerialIntegrator::allocateMemory()
 {
     int retval;    
@@ -127,6 +385,12 @@ int CVODESSerialIntegrator::allocateMemory()
         return (1);
     }
 
+    ysample_ = N_VClone(y_);
+    if(check_retval((void*)ysample_, "N_VClone", 0))
+    {
+        return (1);
+    }
+
     /* 2. Allocating memory for abstol N_Vector */
     abstol_ = N_VNew_Serial(NEQ_, sunctx_);
     if(check_retval((void*)abstol_, "N_VNew_Serial", 0))
@@ -183,8 +447,8 @@ void CVODESSerialIntegrator::allocatesolverMemoryandMethod(int method)
 
 void CVODESSerialIntegrator::initializeintegratorMemoryandRHS()
 {
-    int flag = CVodeInit(cvode_mem_, cvode_rhs, time0_, y_);                    /* Initializing integrator memory and specify the right hand side fn, intial time and initial dependend variable vector */
-    int flag1 = CVodeSetUserData(cvode_mem_, &model_);                          /* There is no error checker with flag1 */
+    int flag = CVodeInit(cvode_mem_, cvode_rhs, time_, y_);                     /* Initializing integrator memory and specify the right hand side fn, intial time and initial dependend variable vector */
+    int flag1 = CVodeSetUserData(cvode_mem_, this);                             /* There is no error checker with flag1 */
 
     if(flag != CV_SUCCESS)
     {
@@ -221,144 +485,1036 @@ void CVODESSerialIntegrator::setrelativeTolerance()
     }
 }
 
-void CVODESSerialIntegrator::createSUNDenseMatrix()
+void CVODESSerialIntegrator::attachNonlinearSolver()
 {
-    A_ = SUNDenseMatrix(NEQ_, NEQ_, sunctx_);
-    /* Write error checks */
-}
+    if(lmm_ != CV_ADAMS)
+    {
+        return;                                                                 /* CVodeInit() attached the default Newton solver */
+    }
 
+    if(NLS_ == nullptr)
+    {
+        NLS_ = SUNNonlinSol_FixedPoint(y_, 0, sunctx_);                         /* 0 = no Anderson acceleration */
+        if(check_retval((void*)NLS_, "SUNNonlinSol_FixedPoint", 0)) return;
+    }
 
-void CVODESSerialIntegrator::createSUNLinSolObject()
-{
-    LS_ = SUNLinSol_Dense(y_, A_, sunctx_);
-    /* Write error checks */
+    int flag = CVodeSetNonlinearSolver(cvode_mem_, NLS_);
+    check_retval(&flag, "CVodeSetNonlinearSolver", 1);
 }
 
 
-void CVODESSerialIntegrator::attachMatrixandLinSol()
+double CVODESSerialIntegrator::estimateSpectralRadius(double t, double *y)
 {
-    int flag = CVodeSetLinearSolver(cvode_mem_, LS_, A_);
-    /* Write error checks using the flag value */
-}
-    
+    int     n    = NEQ_;
+    double *f0   = stiff_f0_.data();
+    double *v    = stiff_v_.data();
+    double *ytmp = stiff_ytmp_.data();
+    double *fv   = stiff_fv_.data();
 
-void CVODESSerialIntegrator::openfileforprinting()
-{
-    FID_ = fopen("0DCPAdReactor_Stats.csv", "w");
-}
+    model_.evalRHS(t, y, f0);
 
+    double ynorm = 0.0;
+    for(int i = 0; i < n; i++)
+    {
+        ynorm += y[i] * y[i];
+        v[i]   = 1.0;
+    }
+    ynorm = std::sqrt(ynorm);
 
-void CVODESSerialIntegrator::destroyN_Vectors()
-{
-    N_VDestroy(y_);       
-    N_VDestroy(abstol_);       
-}
+    /* v <- J*v / |v| by directional differences; |J*v| / |v| tends to max |lambda| */
+    double rho = 0.0;
+    for(int it = 0; it < ChemConfig::STIFFNESS_POWER_ITERS; it++)
+    {
+        double vnorm = 0.0;
+        for(int i = 0; i < n; i++)
+        {
+            vnorm += v[i] * v[i];
+        }
+        vnorm = std::sqrt(vnorm);
+        if(vnorm == 0.0)
+        {
+            break;                                                              /* J*v = 0: nothing left to grow */
+        }
 
+        double sigma = 1.0e-7 * (ynorm + 1.0) / vnorm;
+        for(int i = 0; i < n; i++)
+        {
+            ytmp[i] = y[i] + sigma * v[i];
+        }
+        model_.evalRHS(t, ytmp, fv);
 
-void CVODESSerialIntegrator::freeblockmemory()
-{
-    CVodeFree(&cvode_mem_);
+        double jvnorm = 0.0;
+        for(int i = 0; i < n; i++)
+        {
+            v[i]    = (fv[i] - f0[i]) / (sigma * vnorm);                        /* J*(v/|v|) */
+            jvnorm += v[i] * v[i];
+        }
+        rho = std::sqrt(jvnorm);
+    }
+
+    return rho;
 }
 
 
-void CVODESSerialIntegrator::freesolvermemory()
+int CVODESSerialIntegrator::chooseInitialMethod()
 {
-    SUNLinSolFree(LS_);
-}
+    if(method_ == IntegrationMethod::Adams)
+    {
+        return CV_ADAMS;
+    }
+    if(method_ == IntegrationMethod::BDF || sens_method_ != 0)
+    {
+        return CV_BDF;                                                          /* Rebuilding the session would drop sensitivity memory */
+    }
 
+    stiff_f0_.assign(NEQ_, 0.0);
+    stiff_v_.assign(NEQ_, 0.0);
+    stiff_ytmp_.assign(NEQ_, 0.0);
+    stiff_fv_.assign(NEQ_, 0.0);
 
-void CVODESSerialIntegrator::freematrix()
-{
-    SUNMatDestroy(A_);
-}
+    double *ydata = N_VGetArrayPointer(y_);
+    double  rho   = estimateSpectralRadius(time_, ydata);
+
+    /* Step that changes y by one tolerance unit (WRMS): a conservative accuracy-limited step */
+    double fnorm = 0.0;
+    for(int i = 0; i < NEQ_; i++)
+    {
+        double w = stiff_f0_[i] / (RTOL_ * std::fabs(ydata[i]) + ATOL_[i]);
+        fnorm   += w * w;
+    }
+    fnorm = std::sqrt(fnorm / NEQ_);
 
+    bool stiff = (fnorm == 0.0) || (rho / fnorm > ChemConfig::STIFF_HRHO_TO_BDF);
 
-void CVODESSerialIntegrator::freeSUNDIALScontext()
-{
-    SUNContext_Free(&sunctx_);
+    if(debug_ == 1)
+    {
+        std::cout<<"--Stiffness at start-up: rho = "<<rho<<", h*rho = "
+                 <<((fnorm > 0.0) ? rho / fnorm : 0.0)<<(stiff ? ", BDF" : ", Adams")<<std::endl;
+    }
+
+    return stiff ? CV_BDF : CV_ADAMS;
 }
 
 
-void CVODESSerialIntegrator::closefile()
+void CVODESSerialIntegrator::monitorStiffness()
 {
-    fclose(FID_);
+    if(method_ != IntegrationMethod::Automatic || stiff_f0_.empty())
+    {
+        return;
+    }
+
+    if(++steps_since_check_ < ChemConfig::STIFFNESS_CHECK_STEPS)
+    {
+        return;
+    }
+    steps_since_check_ = 0;
+
+    double h;
+    CVodeGetCurrentStep(cvode_mem_, &h);
+    double hrho = h * estimateSpectralRadius(time_, N_VGetArrayPointer(y_));
+
+    if(lmm_ == CV_ADAMS && hrho > ChemConfig::STIFF_HRHO_TO_BDF)
+    {
+        switchMethod(CV_BDF);
+    }
+    else if(lmm_ == CV_BDF && hrho < ChemConfig::STIFF_HRHO_TO_ADAMS)
+    {
+        switchMethod(CV_ADAMS);
+    }
 }
 
 
-/* Public functions */
-void CVODESSerialIntegrator::initializeandsetupsolver()
+void CVODESSerialIntegrator::switchMethod(int lmm)
 {
-    allocateMemory();
-    setInitialState();
-    setTolerances();
-    allocatesolverMemoryandMethod(1);
+    double h = 0.0;
+    if(cvode_mem_ != nullptr)
+    {
+        CVodeGetCurrentStep(cvode_mem_, &h);
+        CVodeFree(&cvode_mem_);
+    }
+
+    lmm_ = lmm;
+    allocatesolverMemoryandMethod(lmm_);
     initializeintegratorMemoryandRHS();
     setrelativeTolerance();
-    createSUNDenseMatrix();
-    createSUNLinSolObject(); 
     attachMatrixandLinSol();
-    openfileforprinting();
+    attachNonlinearSolver();
+    attachJacobianFn();
+    attachJacobianReuse();
+    attachEvents();
 
-    if(debug_ == 1)
+    CVodeSetInitStep(cvode_mem_, h);
+    if(has_tstop_)
     {
-        std::cout<<"--Initialized and setup solver!"<<std::endl;
+        CVodeSetStopTime(cvode_mem_, tstop_);
     }
+    nswitches_++;
 
+    if(debug_ == 1)
+    {
+        std::cout<<"--Switched to "<<(lmm_ == CV_BDF ? "BDF" : "Adams")<<" at t = "<<time_
+                 <<", h = "<<h<<std::endl;
+    }
 }
 
 
-void CVODESSerialIntegrator::integrate()
+void CVODESSerialIntegrator::setStopTime(double tstop)
 {
-    int iout;
-    int tout; 
-    int flag; 
+    tstop_     = tstop;
+    has_tstop_ = true;
+    CVodeSetStopTime(cvode_mem_, tstop);
+}
 
-    iout = 0;
-    tout = timeop_;
 
-    while(1)
+int CVODESSerialIntegrator::solve(double tout)
+{
+    if(method_ != IntegrationMethod::Automatic || stiff_f0_.empty() || tout <= time_)
     {
-        flag = CVode(cvode_mem_, tout, y_, &time_, CV_NORMAL);
-        /* flag = CVode(cvode_mem_, tout, y_, &time_, CV_ONE_STEP); */
-        /* PrintOutput(time_, NV_Ith_S(y_, 0), NV_Ith_S(y_, 1), NV_Ith_S(y_, 2)); */
-        //PrintAllOutput(time_, y_, NEQ_);
+        return CVode(cvode_mem_, tout, y_, &time_, CV_NORMAL);
+    }
 
-        if(check_retval(&flag, "CVode", 1)) 
-        {
-            std::cout<<"--Error in integration!"<<std::endl;
-            break;
-        }
+    /* A previous overshoot may already cover tout: CVODES' internal time is then
+     * past the last output time and the step to tn can be interpolated without
+     * stepping again (a step from tn would leave tout outside [tn - h, tn]) */
+    double tn = time_;
+    CVodeGetCurrentTime(cvode_mem_, &tn);
+    if(tn >= tout)
+    {
+        int flag = CVodeGetDky(cvode_mem_, tout, 0, y_);
+        time_    = tout;
+        return flag;
+    }
 
-        if(flag == CV_SUCCESS)
+    int flag = CV_SUCCESS;
+    while(time_ < tout)
+    {
+        flag = CVode(cvode_mem_, tout, y_, &time_, CV_ONE_STEP);
+        if(flag < 0 || flag == CV_ROOT_RETURN || flag == CV_TSTOP_RETURN)
         {
-            iout++;
-            tout *= TMULT_;
+            return flag;
         }
 
-        flag = CVodePrintAllStats(cvode_mem_, FID_, SUN_OUTPUTFORMAT_CSV);
-        
-        if(iout == steps_)
+        if(time_ > tout)
         {
-            std::cout<<"Integration done!"<<std::endl;
-            break;
+            /* Stepped past tout: interpolate as CV_NORMAL would */
+            flag = CVodeGetDky(cvode_mem_, tout, 0, y_);
+            time_ = tout;
+            return flag;
         }
-    }
-    fclose(FID_);
 
-    if(debug_ == 1)
-    {
-        printf("\nFinal Statistics:\n");
-        flag = CVodePrintAllStats(cvode_mem_, stdout, SUN_OUTPUTFORMAT_TABLE);
+        monitorStiffness();
     }
 
+    return flag;
 }
 
 
-void CVODESSerialIntegrator::freeMemory()
+void CVODESSerialIntegrator::selectLinearSolver()
 {
-    destroyN_Vectors();   
-    freeblockmemory();    
-    freesolvermemory();   
+    if(linsol_ == LinearSolverType::Automatic)
+    {
+        linsol_ = LinearSolverType::Dense;                                      /* SmallDense/MixedDense are opt-in */
+#ifdef ZEROD_USE_KLU
+        if(NEQ_ > ChemConfig::SPARSE_NEQ_THRESHOLD && model_.hasJacobianPattern())
+        {
+            std::vector<int> colptrs;
+            std::vector<int> rowvals;
+            model_.getJacobianPattern(colptrs, rowvals);
+            if(rowvals.size() <= ChemConfig::SPARSE_MAX_FILL * NEQ_ * NEQ_)
+            {
+                linsol_ = LinearSolverType::Sparse;                             /* KLU on a near-dense pattern loses to dense LU */
+            }
+        }
+#endif
+    }
+
+    if(linsol_ == LinearSolverType::SmallDense && NEQ_ > ChemConfig::SMALL_LU_MAX_NEQ)
+    {
+        std::cout<<"--Small dense LU supports up to "<<ChemConfig::SMALL_LU_MAX_NEQ
+                 <<" equations, using dense"<<std::endl;
+        linsol_ = LinearSolverType::Dense;
+    }
+
+    if(linsol_ == LinearSolverType::Dense && !model_.hasJacobian() && model_.hasJacobianPattern())
+    {
+        linsol_ = LinearSolverType::Sparse;                                     /* Sparse-only model, e.g. ReactorBatchAdapter */
+        if(debug_ == 1)
+        {
+            std::cout<<"--Model provides only a sparse Jacobian, using sparse linear solver"<<std::endl;
+        }
+    }
+
+    if(linsol_ != LinearSolverType::Sparse)
+    {
+        return;
+    }
+
+#ifndef ZEROD_USE_KLU
+    std::cout<<"--Sparse linear solver requested but KLU is not enabled, using dense"<<std::endl;
+    linsol_ = LinearSolverType::Dense;
+#else
+    if(!model_.hasJacobianPattern())
+    {
+        std::cout<<"--Model provides no Jacobian pattern, using dense linear solver"<<std::endl;
+        linsol_ = LinearSolverType::Dense;
+        return;
+    }
+
+    std::vector<int> colptrs;
+    std::vector<int> rowvals;
+    model_.getJacobianPattern(colptrs, rowvals);
+    Jcolptrs_.assign(colptrs.begin(), colptrs.end());
+    Jrowvals_.assign(rowvals.begin(), rowvals.end());
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Sparse Jacobian: "<<Jrowvals_.size()<<" nonzeros of "
+                 <<NEQ_ * NEQ_<<std::endl;
+    }
+#endif
+}
+
+
+void CVODESSerialIntegrator::createSUNDenseMatrix()
+{
+    A_ = SUNDenseMatrix(NEQ_, NEQ_, sunctx_);
+    /* Write error checks */
+}
+
+
+void CVODESSerialIntegrator::createSUNSparseMatrix()
+{
+    A_ = SUNSparseMatrix(NEQ_, NEQ_, Jrowvals_.size(), CSC_MAT, sunctx_);
+    check_retval((void*)A_, "SUNSparseMatrix", 0);
+}
+
+
+void CVODESSerialIntegrator::createSUNLinSolObject()
+{
+#ifdef ZEROD_USE_KLU
+    if(linsol_ == LinearSolverType::Sparse)
+    {
+        LS_ = SUNLinSol_KLU(y_, A_, sunctx_);
+        check_retval((void*)LS_, "SUNLinSol_KLU", 0);
+        return;
+    }
+#endif
+
+    if(linsol_ == LinearSolverType::SPGMR)
+    {
+        int prectype = model_.hasJacobianArrowhead() ? SUN_PREC_LEFT : SUN_PREC_NONE;
+        LS_ = SUNLinSol_SPGMR(y_, prectype, 0, sunctx_);                        /* 0 = default Krylov dimension (5) */
+        check_retval((void*)LS_, "SUNLinSol_SPGMR", 0);
+        return;
+    }
+
+    if(linsol_ == LinearSolverType::SmallDense || linsol_ == LinearSolverType::MixedDense)
+    {
+        LS_ = SUNLinSol_SmallDense(y_, A_, sunctx_, linsol_ == LinearSolverType::MixedDense);
+        check_retval((void*)LS_, "SUNLinSol_SmallDense", 0);
+        return;
+    }
+
+    LS_ = SUNLinSol_Dense(y_, A_, sunctx_);
+    /* Write error checks */
+}
+
+
+void CVODESSerialIntegrator::attachMatrixandLinSol()
+{
+    int flag = CVodeSetLinearSolver(cvode_mem_, LS_, A_);
+    /* Write error checks using the flag value */
+}
+
+
+void CVODESSerialIntegrator::attachJacobianFn()
+{
+    int flag;
+
+    if(linsol_ == LinearSolverType::SPGMR)
+    {
+        if(!model_.hasJacobianArrowhead())
+        {
+            return;                                                             /* Unpreconditioned GMRES */
+        }
+        Pdiag_.assign(NEQ_, 0.0);
+        Prow_.assign(NEQ_, 0.0);
+        Pcol_.assign(NEQ_, 0.0);
+        Mdiag_.assign(NEQ_, 1.0);
+        flag = CVodeSetPreconditioner(cvode_mem_, cvode_psetup, cvode_psolve);
+    }
+    else if(linsol_ != LinearSolverType::Sparse && !model_.hasJacobian())
+    {
+        return;                                                                 /* CVODES falls back to difference quotients */
+    }
+    else if(Jlast_ != nullptr)
+    {
+        flag = CVodeSetLinSysFn(cvode_mem_, cvode_linsys);                      /* Cache/warm restart: we decide when J is current */
+    }
+    else if(linsol_ == LinearSolverType::Sparse)
+    {
+        flag = CVodeSetJacFn(cvode_mem_, cvode_sparse_jac);                     /* Sparse matrices have no DQ fallback */
+    }
+    else
+    {
+        flag = CVodeSetJacFn(cvode_mem_, cvode_jac);
+    }
+    check_retval(&flag, "CVodeSetJacFn", 1);
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Attached analytic Jacobian"<<std::endl;
+    }
+}
+    
+
+bool CVODESSerialIntegrator::reuseJacobian(SUNMatrix J, const double *y, bool evaluated)
+{
+    if(!evaluated)
+    {
+        if(jac_cache_hit_ >= 0)
+        {
+            SUNMatCopy(jac_cache_[jac_cache_hit_].J, J);                        /* A similar cell's Jacobian */
+            jac_cache_hit_ = -1;
+            return true;
+        }
+        if(carry_jacobian_ && use_saved_jac_ && jac_saved_)
+        {
+            use_saved_jac_ = false;
+            SUNMatCopy(Jsaved_, J);
+            return true;
+        }
+        return false;
+    }
+
+    if(jac_cache_store_)
+    {
+        storeCachedJacobian(J, y);
+        jac_cache_store_ = false;
+    }
+    if(carry_jacobian_)
+    {
+        SUNMatCopy(J, Jsaved_);
+        jac_saved_ = true;
+    }
+    return false;
+}
+
+
+void CVODESSerialIntegrator::attachJacobianReuse()
+{
+    int flag;
+
+    if(jac_msbp_ > 0)
+    {
+        flag = CVodeSetLSetupFrequency(cvode_mem_, jac_msbp_);
+        check_retval(&flag, "CVodeSetLSetupFrequency", 1);
+    }
+    if(jac_msbj_ > 0 && linsol_ != LinearSolverType::SPGMR)
+    {
+        flag = CVodeSetJacEvalFrequency(cvode_mem_, jac_msbj_);                 /* SPGMR: psetup's jok decides */
+        check_retval(&flag, "CVodeSetJacEvalFrequency", 1);
+    }
+    if(jac_dgmax_ > 0.0)
+    {
+        flag = CVodeSetDeltaGammaMaxLSetup(cvode_mem_, jac_dgmax_);
+        check_retval(&flag, "CVodeSetDeltaGammaMaxLSetup", 1);
+    }
+}
+
+
+int CVODESSerialIntegrator::findCachedJacobian(const double *y)
+{
+    int    best  = -1;
+    double dbest = 1.0;                                                         /* Acceptance radius in the weighted norm */
+
+    for(int k = 0; k < static_cast<int>(jac_cache_.size()); k++)
+    {
+        const std::vector<double> &yk = jac_cache_[k].y;
+
+        double sum = 0.0;
+        for(int i = 0; i < NEQ_; i++)
+        {
+            double d = (y[i] - yk[i]) / (jac_cache_rtol_ * std::fabs(yk[i]) + ATOL_[i]);
+            sum += d * d;
+        }
+        double dist = std::sqrt(sum / NEQ_);
+
+        if(dist <= dbest)
+        {
+            best  = k;
+            dbest = dist;
+        }
+    }
+
+    return best;
+}
+
+
+void CVODESSerialIntegrator::storeCachedJacobian(SUNMatrix J, const double *y)
+{
+    int slot;
+
+    if(static_cast<int>(jac_cache_.size()) < jac_cache_size_)
+    {
+        jac_cache_.emplace_back();
+        slot                = static_cast<int>(jac_cache_.size()) - 1;
+        jac_cache_[slot].J  = SUNMatClone(J);
+    }
+    else
+    {
+        slot = 0;
+        for(int k = 1; k < static_cast<int>(jac_cache_.size()); k++)
+        {
+            if(jac_cache_[k].stamp < jac_cache_[slot].stamp)
+            {
+                slot = k;                                                       /* Least recently used */
+            }
+        }
+    }
+
+    JacobianCacheEntry &e = jac_cache_[slot];
+    SUNMatCopy(J, e.J);
+    e.y.assign(y, y + NEQ_);
+    e.stamp = ++jac_cache_clock_;
+}
+
+
+void CVODESSerialIntegrator::openfileforprinting()
+{
+    FID_ = fopen("0DCPAdReactor_Stats.csv", "w");
+}
+
+
+void CVODESSerialIntegrator::destroyN_Vectors()
+{
+    N_VDestroy(y_);       
+    N_VDestroy(ysample_);       
+    N_VDestroy(abstol_);       
+    if(yS_ != nullptr)
+    {
+        N_VDestroyVectorArray(yS_, Ns_);
+        yS_ = nullptr;
+    }
+}
+
+
+void CVODESSerialIntegrator::freeblockmemory()
+{
+    CVodeFree(&cvode_mem_);
+}
+
+
+void CVODESSerialIntegrator::freesolvermemory()
+{
+    SUNLinSolFree(LS_);
+    if(NLS_ != nullptr)
+    {
+        SUNNonlinSolFree(NLS_);                                                 /* User-supplied, CVodeFree() leaves it */
+    }
+}
+
+
+void CVODESSerialIntegrator::freematrix()
+{
+    if(A_ != nullptr)
+    {
+        SUNMatDestroy(A_);                                                      /* No matrix in SPGMR mode */
+    }
+    if(Jsaved_ != nullptr)
+    {
+        SUNMatDestroy(Jsaved_);
+    }
+    if(Jlast_ != nullptr)
+    {
+        SUNMatDestroy(Jlast_);
+    }
+    for(JacobianCacheEntry &e : jac_cache_)
+    {
+        SUNMatDestroy(e.J);
+    }
+    jac_cache_.clear();
+}
+
+
+void CVODESSerialIntegrator::freeSUNDIALScontext()
+{
+    SUNContext_Free(&sunctx_);
+}
+
+
+void CVODESSerialIntegrator::closefile()
+{
+    if(FID_ != nullptr)
+    {
+        fclose(FID_);
+        FID_ = nullptr;                                                         /* integrate() and freeMemory() both close */
+    }
+}
+
+
+/* Public functions */
+void CVODESSerialIntegrator::initializeandsetupsolver()
+{
+    time_ = time0_;
+    allocateMemory();
+    setInitialState();
+    setTolerances();
+    selectLinearSolver();
+    if(linsol_ == LinearSolverType::Sparse)
+    {
+        createSUNSparseMatrix();
+    }
+    else if(linsol_ == LinearSolverType::Dense || linsol_ == LinearSolverType::SmallDense ||
+            linsol_ == LinearSolverType::MixedDense)
+    {
+        createSUNDenseMatrix();
+    }
+    createSUNLinSolObject(); 
+    if((carry_jacobian_ || jac_cache_size_ > 0) && A_ != nullptr)
+    {
+        Jlast_ = SUNMatClone(A_);                                               /* J behind A_, for cvode_linsys() */
+    }
+    lmm_ = chooseInitialMethod();
+    allocatesolverMemoryandMethod(lmm_);
+    initializeintegratorMemoryandRHS();
+    setrelativeTolerance();
+    attachMatrixandLinSol();
+    attachNonlinearSolver();
+    attachJacobianFn();
+    attachJacobianReuse();
+    attachEvents();
+    attachSensitivities();
+    if(carry_jacobian_ && A_ != nullptr)
+    {
+        Jsaved_ = SUNMatClone(A_);
+    }
+    jac_cache_store_ = (jac_cache_size_ > 0 && A_ != nullptr);                 /* The first cell fills the cache */
+    openfileforprinting();
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Initialized and setup solver!"<<std::endl;
+    }
+
+}
+
+
+void CVODESSerialIntegrator::integrate()
+{
+    int    flag; 
+    double tfinal = schedule_.finalTime();
+
+    if(schedule_.isSampled())
+    {
+        const std::vector<double> &times = schedule_.times();
+        size_t next = 0;
+
+        /* Samples at or before the current time (e.g. t0) come straight from y_ */
+        while(next < times.size() && times[next] <= time_)
+        {
+            if(observer_)
+            {
+                observer_(times[next], N_VGetArrayPointer(y_));
+            }
+            next++;
+        }
+
+        setStopTime(tfinal);
+        while(next < times.size())
+        {
+            flag = CVode(cvode_mem_, tfinal, y_, &time_, CV_ONE_STEP);
+
+            if(check_retval(&flag, "CVode", 1)) 
+            {
+                std::cout<<"--Error in integration!"<<std::endl;
+                break;
+            }
+            bool stop = (flag == CV_ROOT_RETURN) && recordEvents();
+
+            /* Fill every sample inside the step just completed from the Nordsieck history */
+            while(next < times.size() && times[next] <= time_)
+            {
+                flag = CVodeGetDky(cvode_mem_, times[next], 0, ysample_);
+                if(check_retval(&flag, "CVodeGetDky", 1))
+                {
+                    break;
+                }
+                if(observer_)
+                {
+                    observer_(times[next], N_VGetArrayPointer(ysample_));
+                }
+                next++;
+            }
+
+            if(stop)
+            {
+                break;
+            }
+
+            monitorStiffness();                                                 /* After the samples: a switch drops the history */
+        }
+        flag = CVodePrintAllStats(cvode_mem_, FID_, SUN_OUTPUTFORMAT_CSV);
+    }
+    else if(schedule_.isStreaming())
+    {
+        /* One internal step per call; the stop time keeps CVODES from overshooting tfinal */
+        setStopTime(tfinal);
+        while(time_ < tfinal)
+        {
+            flag = CVode(cvode_mem_, tfinal, y_, &time_, CV_ONE_STEP);
+
+            if(check_retval(&flag, "CVode", 1)) 
+            {
+                std::cout<<"--Error in integration!"<<std::endl;
+                break;
+            }
+
+            if(observer_)
+            {
+                observer_(time_, N_VGetArrayPointer(y_));
+            }
+
+            if(flag == CV_ROOT_RETURN && recordEvents())
+            {
+                break;
+            }
+
+            monitorStiffness();
+        }
+        flag = CVodePrintAllStats(cvode_mem_, FID_, SUN_OUTPUTFORMAT_CSV);
+    }
+    else
+    {
+        bool stop = false;
+
+        for(double tout : schedule_.times())
+        {
+            /* Roots return early; record them and continue towards tout unless terminal */
+            do
+            {
+                flag = solve(tout);
+                /* PrintOutput(time_, NV_Ith_S(y_, 0), NV_Ith_S(y_, 1), NV_Ith_S(y_, 2)); */
+                //PrintAllOutput(time_, y_, NEQ_);
+
+                if(flag == CV_ROOT_RETURN)
+                {
+                    stop = recordEvents();
+                }
+            }
+            while(flag == CV_ROOT_RETURN && !stop);
+
+            if(check_retval(&flag, "CVode", 1)) 
+            {
+                std::cout<<"--Error in integration!"<<std::endl;
+                break;
+            }
+
+            if(stop)
+            {
+                break;
+            }
+
+            if(observer_)
+            {
+                observer_(time_, N_VGetArrayPointer(y_));
+            }
+
+            flag = CVodePrintAllStats(cvode_mem_, FID_, SUN_OUTPUTFORMAT_CSV);
+        }
+    }
+    std::cout<<"Integration done!"<<std::endl;
+    closefile();
+
+    if(debug_ == 1)
+    {
+        printf("\nFinal Statistics:\n");
+        flag = CVodePrintAllStats(cvode_mem_, stdout, SUN_OUTPUTFORMAT_TABLE);
+    }
+
+}
+
+
+void CVODESSerialIntegrator::setOutputSchedule(const OutputSchedule &schedule)
+{
+    schedule_ = schedule;
+}
+
+
+void CVODESSerialIntegrator::setObserver(StepObserver observer)
+{
+    observer_ = std::move(observer);
+}
+
+
+void CVODESSerialIntegrator::addEvent(IntegratorEvent event)
+{
+    events_.push_back(std::move(event));
+}
+
+
+const std::vector<IntegratorEvent>& CVODESSerialIntegrator::getEvents()
+{
+    return events_;
+}
+
+
+void CVODESSerialIntegrator::attachEvents()
+{
+    if(events_.empty())
+    {
+        return;
+    }
+
+    std::vector<int> directions;
+    event_needs_yddot_ = false;
+    for(const IntegratorEvent &ev : events_)
+    {
+        directions.push_back(ev.direction);
+        event_needs_yddot_ = event_needs_yddot_ || ev.needsSecondDerivative;
+    }
+    event_ydot_.assign(NEQ_, 0.0);
+    event_yddot_.assign(NEQ_, 0.0);
+    event_ytmp_.assign(NEQ_, 0.0);
+    rootsfound_.assign(events_.size(), 0);
+
+    int flag = CVodeRootInit(cvode_mem_, events_.size(), cvode_root);
+    check_retval(&flag, "CVodeRootInit", 1);
+
+    flag = CVodeSetRootDirection(cvode_mem_, directions.data());
+    check_retval(&flag, "CVodeSetRootDirection", 1);
+
+    CVodeSetNoInactiveRootWarn(cvode_mem_);                                     /* e.g. T already above a threshold at t0 */
+}
+
+
+bool CVODESSerialIntegrator::recordEvents()
+{
+    bool stop = false;
+
+    CVodeGetRootInfo(cvode_mem_, rootsfound_.data());
+    for(size_t k = 0; k < events_.size(); k++)
+    {
+        if(rootsfound_[k] == 0)
+        {
+            continue;
+        }
+
+        events_[k].times.push_back(time_);
+        if(debug_ == 1)
+        {
+            std::cout<<"--Event "<<events_[k].name<<" at t = "<<time_<<std::endl;
+        }
+
+        if(events_[k].terminal)
+        {
+            std::cout<<"--Integration stopped by event "<<events_[k].name<<" at t = "<<time_<<std::endl;
+            stop = true;
+        }
+    }
+
+    return stop;
+}
+
+
+void CVODESSerialIntegrator::enableSensitivities(int method)
+{
+    sens_method_ = method;
+}
+
+
+void CVODESSerialIntegrator::attachSensitivities()
+{
+    if(sens_method_ == 0 || model_.getNumParameters() == 0)
+    {
+        return;
+    }
+
+    int     flag;
+    double *p = model_.getParameters();
+
+    Ns_ = model_.getNumParameters();
+    yS_ = N_VCloneVectorArray(Ns_, y_);
+    if(check_retval((void*)yS_, "N_VCloneVectorArray", 0))
+    {
+        Ns_ = 0;
+        return;
+    }
+    for(int k = 0; k < Ns_; k++)
+    {
+        N_VConst(0.0, yS_[k]);
+    }
+
+    /* Without the analytic df/dp, CVODES' internal DQ perturbs p in place */
+    CVSensRhsFn fS = model_.hasParameterDerivative() ? cvode_sens_rhs : nullptr;
+    flag = CVodeSensInit(cvode_mem_, Ns_, sens_method_, fS, yS_);
+    if(check_retval(&flag, "CVodeSensInit", 1)) return;
+
+    flag = CVodeSensEEtolerances(cvode_mem_);                                   /* Tolerances scaled by pbar */
+    check_retval(&flag, "CVodeSensEEtolerances", 1);
+
+    flag = CVodeSetSensErrCon(cvode_mem_, SUNTRUE);
+    check_retval(&flag, "CVodeSetSensErrCon", 1);
+
+    pbar_.resize(Ns_);
+    for(int k = 0; k < Ns_; k++)
+    {
+        pbar_[k] = (p[k] != 0.0) ? std::fabs(p[k]) : 1.0;
+    }
+    flag = CVodeSetSensParams(cvode_mem_, p, pbar_.data(), nullptr);
+    check_retval(&flag, "CVodeSetSensParams", 1);
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Forward sensitivities enabled for "<<Ns_<<" parameter(s)"<<std::endl;
+    }
+}
+
+
+int CVODESSerialIntegrator::getSensitivities(std::vector<double> &S)
+{
+    if(Ns_ == 0)
+    {
+        S.clear();
+        return 0;
+    }
+
+    double t;
+    int flag = CVodeGetSens(cvode_mem_, &t, yS_);
+    check_retval(&flag, "CVodeGetSens", 1);
+
+    S.resize(NEQ_ * Ns_);
+    for(int k = 0; k < Ns_; k++)
+    {
+        double *sdata = N_VGetArrayPointer(yS_[k]);
+        std::copy(sdata, sdata + NEQ_, S.begin() + k * NEQ_);
+    }
+
+    return Ns_;
+}
+
+
+void CVODESSerialIntegrator::setWarmRestart(bool carryStep, bool carryJacobian)
+{
+    carry_step_     = carryStep;
+    carry_jacobian_ = carryJacobian;
+}
+
+
+void CVODESSerialIntegrator::setJacobianReuse(long maxStepsSetup, long maxStepsJacobian, double dgmax)
+{
+    jac_msbp_  = maxStepsSetup;
+    jac_msbj_  = maxStepsJacobian;
+    jac_dgmax_ = dgmax;
+}
+
+
+void CVODESSerialIntegrator::setJacobianCache(int size, double rtol)
+{
+    jac_cache_size_ = size;
+    jac_cache_rtol_ = rtol;
+
+    if(size > 0 && (linsol_ == LinearSolverType::SPGMR || (!model_.hasJacobian() && !model_.hasJacobianPattern())))
+    {
+        std::cout<<"--Warning: Jacobian cache is inactive, the model has no Jacobian "
+                 <<"(CVODES difference quotients) or the linear solver is matrix-free"<<std::endl;
+    }
+}
+
+
+void CVODESSerialIntegrator::reset(double t0, double *y0)
+{
+    int    flag;
+    double hlast = 0.0;
+    double *ydata = N_VGetArrayPointer(y_);
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        ydata[i] = y0[i];
+    }
+
+    if(carry_step_)
+    {
+        CVodeGetLastStep(cvode_mem_, &hlast);                                   /* 0 if no step was taken yet */
+    }
+
+    time_      = t0;
+    has_tstop_ = false;                                                         /* The old stop time may lie behind t0 */
+    flag = CVodeReInit(cvode_mem_, t0, y_);                                    /* Same method: monitorStiffness() switches if needed */
+    check_retval(&flag, "CVodeReInit", 1);
+    steps_since_check_ = 0;
+
+    CVodeSetInitStep(cvode_mem_, hlast);                                        /* 0 restores CVODES' own estimate */
+
+    if(Ns_ > 0)
+    {
+        for(int k = 0; k < Ns_; k++)
+        {
+            N_VConst(0.0, yS_[k]);
+        }
+        flag = CVodeSensReInit(cvode_mem_, sens_method_, yS_);
+        check_retval(&flag, "CVodeSensReInit", 1);
+    }
+
+    if(jac_cache_size_ > 0 && A_ != nullptr)
+    {
+        jac_cache_hit_   = findCachedJacobian(y0);
+        jac_cache_store_ = (jac_cache_hit_ < 0);
+        if(jac_cache_hit_ >= 0)
+        {
+            jac_cache_[jac_cache_hit_].stamp = ++jac_cache_clock_;
+            jac_cache_hits_++;
+        }
+    }
+
+    use_saved_jac_ = carry_jacobian_ && jac_saved_ && jac_cache_hit_ < 0;
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--Warm restart at t = "<<t0<<", h0 = "<<hlast<<std::endl;
+    }
+}
+
+
+int CVODESSerialIntegrator::advance(double dt)
+{
+    double tout = time_ + dt;
+
+    int  flag;
+    bool stop = false;
+
+    setStopTime(tout);
+    do
+    {
+        flag = solve(tout);
+        if(flag == CV_ROOT_RETURN)
+        {
+            stop = recordEvents();
+        }
+    }
+    while(flag == CV_ROOT_RETURN && !stop);
+    check_retval(&flag, "CVode", 1);
+
+    return flag;                                                                /* CV_ROOT_RETURN if a terminal event stopped it */
+}
+
+
+void CVODESSerialIntegrator::getState(double *y)
+{
+    double *ydata = N_VGetArrayPointer(y_);
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        y[i] = ydata[i];
+    }
+}
+
+
+void CVODESSerialIntegrator::freeMemory()
+{
+    destroyN_Vectors();   
+    freeblockmemory();    
+    freesolvermemory();   
     freematrix();         
     freeSUNDIALScontext();
     closefile();
@@ -382,3 +1538,41 @@ double CVODESSerialIntegrator::getfirstEqn()
 {
     return NV_Ith_S(y_, 1);
 }
+
+
+long CVODESSerialIntegrator::getNumberofMethodSwitches()
+{
+    return nswitches_;
+}
+
+
+long CVODESSerialIntegrator::getNumberofLinearSetups()
+{
+    long n = 0;
+    CVodeGetNumLinSolvSetups(cvode_mem_, &n);
+    return n;
+}
+
+
+long CVODESSerialIntegrator::getNumberofJacobianEvals()
+{
+    long n = 0;
+    CVodeGetNumJacEvals(cvode_mem_, &n);
+    return n;
+}
+
+
+long CVODESSerialIntegrator::getNumberofJacobianCacheHits()
+{
+    return jac_cache_hits_;
+}
+
+
+long CVODESSerialIntegrator::getNumberofRefinements()
+{
+    if(linsol_ != LinearSolverType::MixedDense || LS_ == nullptr)
+    {
+        return 0;
+    }
+    return SUNLinSol_SmallDenseNumRefinements(LS_);
+}
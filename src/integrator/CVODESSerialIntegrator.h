@@ -21,9 +21,50 @@
 #include <nvector/nvector_serial.h> 						                    /*!< Access to serial N_Vector            */
 #include <sunlinsol/sunlinsol_dense.h> 						                    /*!< Access to dense SUNLinearSolver      */
 #include <sunmatrix/sunmatrix_dense.h> 						                    /*!< Access to dense SUNMatrix            */
+#include <sunmatrix/sunmatrix_sparse.h> 						                    /*!< Access to sparse SUNMatrix           */
+#include <sunlinsol/sunlinsol_spgmr.h> 						                    /*!< Access to SPGMR SUNLinearSolver      */
+#include "SUNLinSolSmallDense.h"                                                /*!< Size-specialized dense LU solver      */
+#include <sunnonlinsol/sunnonlinsol_fixedpoint.h> 					                /*!< Access to fixed-point SUNNonlinearSolver */
+#ifdef ZEROD_USE_KLU
+#include <sunlinsol/sunlinsol_klu.h> 						                    /*!< Access to KLU sparse SUNLinearSolver */
+#endif
 /** @} */
 
+#include "ChemConfig.h"                                                         /*!< Default reuse options. */
 #include "Utility.h"                                                            /*!< Model interface to provide setNEQ(), setInitialState(), evalRHS(), etc. */
+#include "OutputSchedule.h"                                                     /*!< Output times and per-step observer. */
+#include "IntegratorEvent.h"                                                    /*!< Root-finding events. */
+
+
+/**
+ * @brief Linear solver used inside the CVODES Newton iteration.
+ */
+enum class LinearSolverType
+{
+    Dense,                                                                      /*!< SUNDenseMatrix + SUNLinSol_Dense.                                      */
+    SmallDense,                                                                 /*!< SUNDenseMatrix + SUNLinSol_SmallDense (size-specialized LU); dense
+                                                                                     above ChemConfig::SMALL_LU_MAX_NEQ equations.                          */
+    MixedDense,                                                                 /*!< SUNDenseMatrix + SUNLinSol_SmallDense with float factors and iterative
+                                                                                     refinement in double; any size.                                        */
+    Sparse,                                                                     /*!< SUNSparseMatrix (CSC) + SUNLinSol_KLU; needs Utility::hasJacobianPattern(). */
+    SPGMR,                                                                      /*!< Matrix-free GMRES; Jv by difference quotients of evalRHS(), preconditioned
+                                                                                     with Utility::evalJacobianArrowhead() when available.                     */
+    Automatic                                                                   /*!< Sparse above ChemConfig::SPARSE_NEQ_THRESHOLD equations if KLU is built
+                                                                                     and the pattern fills at most ChemConfig::SPARSE_MAX_FILL, else Dense;
+                                                                                     SmallDense and MixedDense are only used when requested.               */
+};
+
+
+/**
+ * @brief Linear multistep method and nonlinear iteration.
+ */
+enum class IntegrationMethod
+{
+    Adams,                                                                      /*!< CV_ADAMS + fixed-point iteration (non-stiff, no Jacobian).             */
+    BDF,                                                                        /*!< CV_BDF + Newton with the selected linear solver (stiff).               */
+    Automatic                                                                   /*!< Pick from a stiffness estimate at start-up and switch during the run at
+                                                                                     ChemConfig::STIFF_HRHO_TO_BDF / STIFF_HRHO_TO_ADAMS.                      */
+};
 
 
 /**
@@ -33,7 +74,7 @@
  *  TODO: 
  *  Expand on:
  *      - Error handling strategy and debug modes.
- *      - Step/output scheduling via @ref timeop_ and @ref TMULT_.
+ *      - Output scheduling via @ref OutputSchedule (see setOutputSchedule()).
  */
 class CVODESSerialIntegrator
 {
@@ -45,6 +86,25 @@ class CVODESSerialIntegrator
          * @post Internals are default-initialized; allocate/setup occurs in initializeandsetupsolver().
          */
         explicit CVODESSerialIntegrator (Utility &model, int debug = 0);
+        /**
+         * @brief Choose the linear solver; call before initializeandsetupsolver().
+         * @param[in] type Dense, SmallDense, MixedDense, Sparse, SPGMR or Automatic (default: Dense).
+         * @note Sparse falls back to dense when the model has no Jacobian pattern or
+         *       the build lacks KLU (compile with -DZEROD_USE_KLU).
+         */
+        void setLinearSolverType(LinearSolverType type);
+        /**
+         * @brief Choose the integration method; call before initializeandsetupsolver().
+         * @param[in] method Adams, BDF or Automatic (default: Automatic).
+         * @details
+         *   Automatic estimates the spectral radius rho of the Jacobian by power iteration on
+         *   RHS differences and compares h*rho with the ChemConfig thresholds: at start-up with
+         *   the step that changes y by one tolerance unit, then every
+         *   ChemConfig::STIFFNESS_CHECK_STEPS internal steps with CVODES' current step. A switch
+         *   rebuilds the CVODES session at the current state, keeping the step size; statistics
+         *   restart with it. Sensitivity runs stay on BDF.
+         */
+        void setIntegrationMethod(IntegrationMethod method);
         /**
          * @brief Allocate objects and configure solver/integrator.
          */
@@ -52,10 +112,110 @@ class CVODESSerialIntegrator
         /**
          * @brief Run time integration with CVODES and print stats/output.
          * @details
-         *   TODO: Describe output cadence (timeop_ × TMULT_ for steps_ iterations) and exit conditions.
+         *   Stops at every time of the output schedule (CV_NORMAL) and calls the observer
+         *   there, or, for a streaming schedule, takes CV_ONE_STEP steps up to the final
+         *   time and calls the observer after each one. For a sampled schedule it steps
+         *   freely and calls the observer with CVodeGetDky() interpolants at the requested
+         *   times. Default schedule: 12 logarithmic outputs from 1 s to 1e11 s. Stops
+         *   early on a CVODES error.
          * @post Integration performed; statistics printed; file closed.
          */
         void integrate();
+        /**
+         * @brief Replace the output schedule used by integrate().
+         * @param[in] schedule Linear, logarithmic, listed or streaming output times.
+         */
+        void setOutputSchedule(const OutputSchedule &schedule);
+        /**
+         * @brief Register a callback invoked with (t, y) at each output / internal step.
+         * @param[in] observer Callback; an empty function disables it.
+         */
+        void setObserver(StepObserver observer);
+        /**
+         * @brief Register a root-finding event; call before initializeandsetupsolver().
+         * @param[in] event Event function, direction and stop policy (see @ref IntegratorEvent).
+         * @details Crossing times are recorded in the event; a terminal event makes
+         *          integrate() and advance() return at the crossing.
+         */
+        void addEvent(IntegratorEvent event);
+        /**
+         * @brief Registered events with their recorded crossing times.
+         */
+        const std::vector<IntegratorEvent>& getEvents();
+        /**
+         * @brief Enable forward sensitivities w.r.t. the model parameters; call before initializeandsetupsolver().
+         * @param[in] method CV_STAGGERED (default) or CV_SIMULTANEOUS corrector.
+         * @details
+         *   One sensitivity s_k = dy/dp_k per @ref Utility::getParameters() entry is integrated
+         *   with the state, s_k' = J s_k + df/dp_k, in one CVODES run instead of one perturbed
+         *   run per parameter. J s_k is a directional difference of evalRHS(); df/dp_k is analytic
+         *   when the model implements @ref Utility::evalParameterDerivative(), otherwise CVODES
+         *   perturbs the parameters in place. No-op for models without parameters.
+         *   IdealGasConstPressureAdiabaticReactor has one parameter, a global rate multiplier,
+         *   so with it this is a global-rate sensitivity, not a per-reaction one.
+         */
+        void enableSensitivities(int method = CV_STAGGERED);
+        /**
+         * @brief Sensitivities at the current time.
+         * @param[out] S Resized to NEQ × Ns, column-major: S[k*NEQ + i] = dy_i/dp_k.
+         * @return Number of parameters Ns (0 if sensitivities are disabled).
+         */
+        int getSensitivities(std::vector<double> &S);
+        /**
+         * @brief Choose what a warm restart carries over; call before initializeandsetupsolver().
+         * @param[in] carryStep Start each reset() with the last step size instead of CVODES' estimate.
+         * @param[in] carryJacobian Serve the first Jacobian request after reset() from the last
+         *            evaluated Jacobian (needs @ref Utility::hasJacobian() or the sparse path).
+         */
+        void setWarmRestart(bool carryStep, bool carryJacobian);
+        /**
+         * @brief Control how often CVODES refreshes the Newton matrix and the Jacobian; call before initializeandsetupsolver().
+         * @param[in] maxStepsSetup Steps between setups, i.e. factorizations of I - gamma*J (CVODES msbp).
+         * @param[in] maxStepsJacobian Steps between Jacobian evaluations (CVODES msbj).
+         * @param[in] dgmax Relative change of gamma since the last setup that forces a new one.
+         * @details Larger values trade Newton iterations for fewer setups; a convergence failure
+         *          still forces a fresh Jacobian. Kept across method switches.
+         */
+        void setJacobianReuse(long maxStepsSetup = ChemConfig::JAC_MAX_STEPS_SETUP,
+                              long maxStepsJacobian = ChemConfig::JAC_MAX_STEPS_EVAL,
+                              double dgmax = ChemConfig::JAC_DGMAX_SETUP);
+        /**
+         * @brief Cache Jacobians across cells; call before initializeandsetupsolver().
+         * @param[in] size Number of cached Jacobians (0 disables the cache).
+         * @param[in] rtol Acceptance radius: weighted RMS distance of y0 from the state a Jacobian
+         *            was evaluated at, with weights 1 / (rtol*|y| + ATOL).
+         * @details
+         *   On reset(), the closest cached Jacobian within the radius serves the first Jacobian
+         *   request of the new cell. On a miss the cell's first evaluated Jacobian is stored,
+         *   replacing the least recently used entry. Needs the model's Jacobian
+         *   (@ref Utility::hasJacobian() or the sparse path) and warns otherwise; takes precedence
+         *   over the Jacobian carried by setWarmRestart(). A cached Jacobian is handed to CVODES
+         *   as stale, so a Newton failure forces a real evaluation.
+         */
+        void setJacobianCache(int size = ChemConfig::JAC_CACHE_SIZE, double rtol = ChemConfig::JAC_CACHE_RTOL);
+        /**
+         * @brief Restart the session from a new initial condition, keeping all SUNDIALS objects.
+         * @param[in] t0 Initial time [s].
+         * @param[in] y0 Initial state (length = NEQ).
+         * @pre initializeandsetupsolver() has been called.
+         * @post CVodeReInit() applied; no allocation takes place.
+         * @note With IntegrationMethod::Automatic the current method is kept: the start-up
+         *       stiffness estimate (1 + STIFFNESS_POWER_ITERS RHS evaluations) and a session
+         *       rebuild per cell would undo the point of a warm restart. monitorStiffness()
+         *       switches after the first steps if the new cell needs the other method.
+         */
+        void reset(double t0, double *y0);
+        /**
+         * @brief Integrate from the current time by @p dt, stopping exactly at t + dt.
+         * @param[in] dt Time step [s].
+         * @return CVode() flag (negative on failure).
+         */
+        int advance(double dt);
+        /**
+         * @brief Copy the current state vector.
+         * @param[out] y State (length = NEQ).
+         */
+        void getState(double *y);
         /**
          * @brief Release all allocated SUNDIALS resources and files.
          * @post All owned resources freed safely (idempotent if called once).
@@ -80,18 +240,61 @@ class CVODESSerialIntegrator
          * @note Provided for quick inspection during debugging.
          */
         double getfirstEqn();
+        /**
+         * @brief Number of Adams/BDF switches made so far (Automatic only).
+         */
+        long getNumberofMethodSwitches();
+        /**
+         * @brief Newton matrix setups (factorizations) of the current session.
+         */
+        long getNumberofLinearSetups();
+        /**
+         * @brief Jacobian requests of the current session, cache hits included.
+         */
+        long getNumberofJacobianEvals();
+        /**
+         * @brief reset() calls served from the Jacobian cache so far.
+         */
+        long getNumberofJacobianCacheHits();
+        /**
+         * @brief Iterative-refinement sweeps of the MixedDense solver (0 for other solvers).
+         */
+        long getNumberofRefinements();
 
 
     private:
 
         int    NEQ_;                                                            /*!< Number of equations (model dimension).                     */
         double time0_;                                                          /*!< Initial time [s].                                          */
-        double timeop_;                                                         /*!< Output time for first report [s].                          */
         double time_;                                                           /*!< Current integrator time [s].                               */
-        double timefinal_;                                                      /*!< Final time [s].                                            */
-        double TMULT_;                                                          /*!< Multiplicative factor for successive output times.         */
         double timeInteg_;                                                      /*!< Wall/CPU integration time (if measured).                   */
-        int    steps_;                                                          /*!< Number of output steps (loop count).                       */    
+        OutputSchedule schedule_;                                               /*!< Output times used by integrate().                          */
+        StepObserver   observer_;                                               /*!< Optional per-output callback.                              */
+
+        IntegrationMethod   method_;                                            /*!< Requested method.                                          */
+        int                 lmm_;                                               /*!< Method of the live session: CV_ADAMS or CV_BDF.            */
+        SUNNonlinearSolver  NLS_;                                               /*!< Fixed-point solver for Adams (BDF uses CVODES' Newton).    */
+        long                nswitches_;                                         /*!< Method switches so far.                                    */
+        long                steps_since_check_;                                 /*!< Internal steps since the last stiffness check.             */
+        double              tstop_;                                             /*!< Stop time, re-applied after a switch.                      */
+        bool                has_tstop_;                                         /*!< @ref tstop_ is set.                                        */
+        std::vector<double> stiff_f0_;                                          /*!< RHS at the state being tested.                             */
+        std::vector<double> stiff_v_;                                           /*!< Power-iteration vector.                                    */
+        std::vector<double> stiff_ytmp_;                                        /*!< Perturbed state.                                           */
+        std::vector<double> stiff_fv_;                                          /*!< RHS at the perturbed state.                                */
+
+        std::vector<IntegratorEvent> events_;                                   /*!< Root-finding events.                                       */
+        std::vector<int>    rootsfound_;                                        /*!< CVodeGetRootInfo() output.                                 */
+        std::vector<double> event_ydot_;                                        /*!< RHS scratch for event functions.                           */
+        std::vector<double> event_yddot_;                                       /*!< d(ydot)/dt scratch for event functions.                    */
+        std::vector<double> event_ytmp_;                                        /*!< Perturbed state scratch for d(ydot)/dt.                    */
+        bool                event_needs_yddot_;                                 /*!< Any event reads yddot.                                     */
+
+        int                 sens_method_;                                       /*!< CV_STAGGERED/CV_SIMULTANEOUS; 0 = sensitivities disabled.  */
+        int                 Ns_;                                                /*!< Number of sensitivity parameters.                          */
+        N_Vector*           yS_;                                                /*!< Sensitivity vectors dy/dp_k.                               */
+        std::vector<double> pbar_;                                              /*!< Parameter scales for error control and DQ perturbations.   */
+
 
         
         void*     cvode_mem_;                                                   /*!< CVODES memory block pointer (session handle). */
@@ -101,8 +304,45 @@ class CVODESSerialIntegrator
         std::vector<double> ATOL_;                                              /*!< Host-side copy for absolute tolerances. */
 
         N_Vector  y_;                                                           /*!< State vector. */
-        SUNMatrix A_;                                                           /*!< Dense Jacobian/SUNMatrix. */
-        SUNLinearSolver LS_;                                                    /*!< Dense linear solver.  */
+        N_Vector  ysample_;                                                     /*!< Interpolated state for sampled schedules. */
+        SUNMatrix A_;                                                           /*!< Dense or sparse Jacobian/SUNMatrix. */
+        SUNLinearSolver LS_;                                                    /*!< Dense or KLU linear solver.  */
+        LinearSolverType linsol_;                                               /*!< Selected linear solver. */
+        SUNMatrix Jsaved_;                                                      /*!< Copy of the last evaluated Jacobian (warm restart). */
+        SUNMatrix Jlast_;                                                       /*!< J behind the current Newton matrix, when the cache or
+                                                                                     warm restart is on (see cvode_linsys()).             */
+        bool      carry_step_;                                                  /*!< reset() reuses the last step size.                   */
+        bool      carry_jacobian_;                                              /*!< reset() reuses the last Jacobian.                    */
+        bool      jac_saved_;                                                   /*!< @ref Jsaved_ holds a valid Jacobian.                 */
+        bool      use_saved_jac_;                                               /*!< Next Jacobian request is served from @ref Jsaved_.   */
+        long      jac_msbp_;                                                    /*!< Steps between setups; 0 = CVODES default.            */
+        long      jac_msbj_;                                                    /*!< Steps between Jacobians; 0 = CVODES default.         */
+        double    jac_dgmax_;                                                   /*!< gamma change forcing a setup; 0 = CVODES default.    */
+
+        /**
+         * @brief One cached Jacobian and the state it was evaluated at.
+         */
+        struct JacobianCacheEntry
+        {
+            SUNMatrix           J     = nullptr;                                /*!< Jacobian (clone of @ref A_).                         */
+            std::vector<double> y;                                              /*!< State at evaluation.                                 */
+            long                stamp = 0;                                      /*!< Last use, for LRU replacement.                       */
+        };
+        std::vector<JacobianCacheEntry> jac_cache_;                             /*!< Cross-cell Jacobian cache.                           */
+        int       jac_cache_size_;                                              /*!< Capacity; 0 = disabled.                              */
+        double    jac_cache_rtol_;                                              /*!< Acceptance radius, see setJacobianCache().           */
+        int       jac_cache_hit_;                                               /*!< Entry serving the next Jacobian request; -1 = none.  */
+        bool      jac_cache_store_;                                             /*!< Store the next evaluated Jacobian.                   */
+        long      jac_cache_clock_;                                             /*!< LRU clock.                                           */
+        long      jac_cache_hits_;                                              /*!< reset() calls served from the cache.                 */
+        std::vector<sunindextype> Jcolptrs_;                                    /*!< CSC column pointers of the model's Jacobian pattern. */
+        std::vector<sunindextype> Jrowvals_;                                    /*!< CSC row indices of the model's Jacobian pattern. */
+        std::vector<double> Pdiag_;                                             /*!< Arrowhead preconditioner: Jacobian diagonal.        */
+        std::vector<double> Prow_;                                              /*!< Arrowhead preconditioner: Jacobian first row.       */
+        std::vector<double> Pcol_;                                              /*!< Arrowhead preconditioner: Jacobian first column.    */
+        std::vector<double> Mdiag_;                                             /*!< Diagonal of M = I - gamma*J (arrowhead part).       */
+        double              Mschur_;                                            /*!< Schur complement of the species block of M.         */
+        double              Mgamma_;                                            /*!< gamma used to form M.                               */
         SUNContext sunctx_;                                                     /*!< SUNDIALS context (logs/errors/profiling). */
 
 
@@ -151,12 +391,62 @@ class CVODESSerialIntegrator
          */
         void initializeintegratorMemoryandRHS();
 
+        /**
+         * @brief Attach the fixed-point nonlinear solver when @ref lmm_ is CV_ADAMS.
+         */
+        void attachNonlinearSolver();
+
+        /**
+         * @brief Spectral radius of the Jacobian by power iteration on RHS differences.
+         * @param[in] t Time.
+         * @param[in] y State (length = NEQ).
+         * @return Estimate of max |lambda(J)| [1/s].
+         */
+        double estimateSpectralRadius(double t, double *y);
+
+        /**
+         * @brief Method for a (re)start from @ref y_ at @ref time_.
+         * @return CV_ADAMS or CV_BDF according to @ref method_ and, for Automatic, h*rho(J).
+         */
+        int chooseInitialMethod();
+
+        /**
+         * @brief Count one internal step and, every ChemConfig::STIFFNESS_CHECK_STEPS, test h*rho(J).
+         * @post The session may have been rebuilt with the other method.
+         */
+        void monitorStiffness();
+
+        /**
+         * @brief Rebuild the CVODES session with @p lmm at (@ref time_, @ref y_).
+         * @details Linear solver, matrix, Jacobian, events and stop time carry over; the
+         *          current step size seeds the new session.
+         */
+        void switchMethod(int lmm);
+
+        /**
+         * @brief CVodeSetStopTime() that is remembered for switchMethod().
+         */
+        void setStopTime(double tstop);
+
+        /**
+         * @brief Integrate to @p tout like CVode(CV_NORMAL), stepping with CV_ONE_STEP when
+         *        the method is Automatic so stiffness can be monitored.
+         * @return CVode() flag.
+         */
+        int solve(double tout);
+
         /**
          * @brief Apply scalar-relative, vector-absolute tolerances to session.
          * @post Tolerances active in CVODES run.
          */
         void setrelativeTolerance();
 
+        /**
+         * @brief Resolve Automatic/Sparse into the solver this build and model support.
+         * @post @ref linsol_ is Dense, SmallDense, MixedDense, Sparse or SPGMR; for Sparse, @ref Jcolptrs_ and @ref Jrowvals_ are set.
+         */
+        void selectLinearSolver();
+
         /**
          * @brief Create dense SUNMatrix sized NEQ_×NEQ_.
          * @post @ref A_ valid on success.
@@ -164,7 +454,13 @@ class CVODESSerialIntegrator
         void createSUNDenseMatrix();
 
         /**
-         * @brief Create dense SUNLinearSolver for (@ref y_, @ref A_).
+         * @brief Create CSC SUNSparseMatrix sized NEQ_×NEQ_ with the model's pattern's nnz.
+         * @post @ref A_ valid on success.
+         */
+        void createSUNSparseMatrix();
+
+        /**
+         * @brief Create dense, small dense, KLU or SPGMR SUNLinearSolver for (@ref y_, @ref A_).
          * @post @ref LS_ valid on success.
          */
         void createSUNLinSolObject(); 
@@ -175,6 +471,56 @@ class CVODESSerialIntegrator
          */
         void attachMatrixandLinSol();
 
+        /**
+         * @brief Attach the model's analytic Jacobian, if it provides one.
+         * @post CVodeSetJacFn() called when @ref Utility::hasJacobian() is true (CVodeSetLinSysFn()
+         *       when Jacobians are reused across cells); otherwise CVODES keeps its
+         *       difference-quotient Jacobian.
+         */
+        void attachJacobianFn();
+
+        /**
+         * @brief Serve a Jacobian request from the cache or @ref Jsaved_ after a restart, or save a fresh one.
+         * @param[in,out] J Jacobian passed to the CVODES callback.
+         * @param[in] y State of the request (length = NEQ).
+         * @param[in] evaluated false before evaluation (may copy in), true after (may copy out).
+         * @return true if @p J was filled from a saved Jacobian and no evaluation is needed.
+         */
+        bool reuseJacobian(SUNMatrix J, const double *y, bool evaluated);
+
+        /**
+         * @brief Apply the setJacobianReuse() options to the live session.
+         */
+        void attachJacobianReuse();
+
+        /**
+         * @brief Closest cached Jacobian to @p y within the acceptance radius.
+         * @return Entry index, or -1 if none qualifies.
+         */
+        int findCachedJacobian(const double *y);
+
+        /**
+         * @brief Store @p J, evaluated at @p y, replacing the least recently used entry when full.
+         */
+        void storeCachedJacobian(SUNMatrix J, const double *y);
+
+        /**
+         * @brief Register @ref events_ with CVodeRootInit() and set their directions.
+         */
+        void attachEvents();
+
+        /**
+         * @brief Record the crossing time of every event that fired at @ref time_.
+         * @return true if a terminal event fired.
+         */
+        bool recordEvents();
+
+        /**
+         * @brief Allocate the sensitivity vectors and register them with CVodeSensInit().
+         * @post @ref yS_ zeroed (initial state does not depend on the parameters).
+         */
+        void attachSensitivities();
+
         /**
          * @brief Open CSV file for printing solver statistics.
          * @post @ref FID_ opened for write.
@@ -183,8 +529,61 @@ class CVODESSerialIntegrator
 
 
         /* 2. Integrator fns */
-        /* int cvode_rhs(double t, N_Vector y, 
-         * N_Vector ydot, void* user_data); */                                  /* Cannot have it as a member function */
+        /* CVODES callbacks are static members so that user_data can carry `this`
+         * and reach both the model and the integrator's own state. */
+
+        /**
+         * @brief CVODES RHS callback; forwards to @ref Utility::evalRHS().
+         */
+        static int cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data);
+
+        /**
+         * @brief CVODES dense Jacobian callback; forwards to @ref Utility::evalJacobian().
+         */
+        static int cvode_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+        /**
+         * @brief CVODES sparse Jacobian callback; writes the CSC pattern and forwards
+         *        the values to @ref Utility::evalSparseJacobian().
+         */
+        static int cvode_sparse_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                                    N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+        /**
+         * @brief CVODES linear-system callback, A = I - gamma*J, used when Jacobians are reused
+         *        across cells (cache or warm restart).
+         * @details A Jacobian served by reuseJacobian() belongs to another cell, so it is reported
+         *          as not current (*jcur = false): the first Newton failure then makes CVODES
+         *          request a fresh J at the same step instead of cutting the step.
+         */
+        static int cvode_linsys(double t, N_Vector y, N_Vector fy, SUNMatrix A, sunbooleantype jok,
+                                sunbooleantype *jcur, double gamma, void* user_data,
+                                N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+        /**
+         * @brief CVODES root function: evaluates every event function.
+         */
+        static int cvode_root(double t, N_Vector y, double *gout, void* user_data);
+
+        /**
+         * @brief CVODES sensitivity RHS: s_k' = J s_k + df/dp_k for all parameters.
+         */
+        static int cvode_sens_rhs(int Ns, double t, N_Vector y, N_Vector ydot, N_Vector *yS,
+                                  N_Vector *ySdot, void* user_data, N_Vector tmp1, N_Vector tmp2);
+
+        /**
+         * @brief CVODES preconditioner setup: evaluate (or reuse) the arrowhead Jacobian
+         *        and factor M = I - gamma*J restricted to it.
+         */
+        static int cvode_psetup(double t, N_Vector y, N_Vector fy, sunbooleantype jok,
+                                sunbooleantype *jcurPtr, double gamma, void* user_data);
+
+        /**
+         * @brief CVODES preconditioner solve: z = M^{-1} r in O(NEQ).
+         */
+        static int cvode_psolve(double t, N_Vector y, N_Vector fy, N_Vector r, N_Vector z,
+                                double gamma, double delta, int lr, void* user_data);
 
         /* 3. Free memory */
         /**
@@ -0,0 +1,126 @@
+/**
+ * @file Dual.h
+ * @brief Multi-lane dual numbers for forward-mode automatic differentiation.
+ * @details
+ *  Dual<L> carries a value and L directional derivatives. Seeding lane q of
+ *  input j with 1 makes lane q of every output its derivative w.r.t. input j,
+ *  so one pass over a function templated on its scalar type yields L exact
+ *  Jacobian columns. The lane loops have a compile-time trip count and compile
+ *  to SIMD arithmetic at -O3.
+ *
+ *  Comparisons act on the value only, so branches (e.g. a NASA midpoint) pick
+ *  the same side as the double evaluation.
+ */
+
+#ifndef SRC_INTEGRATOR_DUAL
+#define SRC_INTEGRATOR_DUAL
+
+#include <cmath>
+
+
+/**
+ * @brief Value plus @p L derivative lanes.
+ * @tparam L Number of derivative lanes (Jacobian columns per pass).
+ */
+template<int L>
+struct Dual
+{
+    double v;                                                                   /*!< Value.             */
+    double d[L];                                                                /*!< Derivative lanes.  */
+
+    Dual() : v(0.0)
+    {
+        for(int q = 0; q < L; q++) d[q] = 0.0;
+    }
+
+    Dual(double value) : v(value)                                               /* Constants: zero derivative */
+    {
+        for(int q = 0; q < L; q++) d[q] = 0.0;
+    }
+
+    Dual& operator+=(const Dual &b) { v += b.v; for(int q = 0; q < L; q++) d[q] += b.d[q]; return *this; }
+    Dual& operator-=(const Dual &b) { v -= b.v; for(int q = 0; q < L; q++) d[q] -= b.d[q]; return *this; }
+    Dual& operator*=(const Dual &b) { *this = *this * b; return *this; }
+    Dual& operator/=(const Dual &b) { *this = *this / b; return *this; }
+
+    Dual& operator+=(double b) { v += b; return *this; }
+    Dual& operator-=(double b) { v -= b; return *this; }
+    Dual& operator*=(double b) { v *= b; for(int q = 0; q < L; q++) d[q] *= b; return *this; }
+    Dual& operator/=(double b) { return *this *= (1.0 / b); }
+
+    friend Dual operator-(const Dual &a)
+    {
+        Dual r; r.v = -a.v;
+        for(int q = 0; q < L; q++) r.d[q] = -a.d[q];
+        return r;
+    }
+
+    friend Dual operator+(Dual a, const Dual &b) { return a += b; }
+    friend Dual operator-(Dual a, const Dual &b) { return a -= b; }
+    friend Dual operator+(Dual a, double b)      { return a += b; }
+    friend Dual operator+(double a, Dual b)      { return b += a; }
+    friend Dual operator-(Dual a, double b)      { return a -= b; }
+    friend Dual operator-(double a, const Dual &b) { return -b + a; }
+    friend Dual operator*(Dual a, double b)      { return a *= b; }
+    friend Dual operator*(double a, Dual b)      { return b *= a; }
+    friend Dual operator/(Dual a, double b)      { return a /= b; }
+
+    friend Dual operator*(const Dual &a, const Dual &b)
+    {
+        Dual r; r.v = a.v * b.v;
+        for(int q = 0; q < L; q++) r.d[q] = a.d[q] * b.v + a.v * b.d[q];
+        return r;
+    }
+
+    friend Dual operator/(const Dual &a, const Dual &b)
+    {
+        double inv = 1.0 / b.v;
+        Dual   r;  r.v = a.v * inv;
+        for(int q = 0; q < L; q++) r.d[q] = (a.d[q] - r.v * b.d[q]) * inv;
+        return r;
+    }
+
+    friend Dual operator/(double a, const Dual &b) { return Dual(a) / b; }
+
+    friend bool operator< (const Dual &a, const Dual &b) { return a.v <  b.v; }
+    friend bool operator> (const Dual &a, const Dual &b) { return a.v >  b.v; }
+    friend bool operator<=(const Dual &a, const Dual &b) { return a.v <= b.v; }
+    friend bool operator>=(const Dual &a, const Dual &b) { return a.v >= b.v; }
+    friend bool operator==(const Dual &a, const Dual &b) { return a.v == b.v; }
+    friend bool operator!=(const Dual &a, const Dual &b) { return a.v != b.v; }
+};
+
+
+/** @name Elementary functions: value through <cmath>, lanes scaled by the derivative
+ *  @{ */
+template<int L>
+Dual<L> chain(const Dual<L> &a, double value, double dfda)
+{
+    Dual<L> r; r.v = value;
+    for(int q = 0; q < L; q++) r.d[q] = dfda * a.d[q];
+    return r;
+}
+
+template<int L> Dual<L> exp (const Dual<L> &a)           { double e = std::exp(a.v);  return chain(a, e, e); }
+template<int L> Dual<L> log (const Dual<L> &a)           { return chain(a, std::log(a.v), 1.0 / a.v); }
+template<int L> Dual<L> sqrt(const Dual<L> &a)           { double s = std::sqrt(a.v); return chain(a, s, 0.5 / s); }
+template<int L> Dual<L> pow (const Dual<L> &a, double n) { return chain(a, std::pow(a.v, n), n * std::pow(a.v, n - 1.0)); }
+template<int L> Dual<L> fabs(const Dual<L> &a)           { return a.v < 0.0 ? -a : a; }
+
+template<int L> Dual<L> pow(const Dual<L> &a, const Dual<L> &b)
+{
+    return exp(b * log(a));
+}
+/** @} */
+
+
+/**
+ * @brief Value of a double or a dual, for code templated on the scalar type.
+ */
+inline double value(double a) { return a; }
+
+template<int L>
+double value(const Dual<L> &a) { return a.v; }
+
+
+#endif /* SRC_INTEGRATOR_DUAL */
@@ -0,0 +1,350 @@
+/**
+ * @file ISATTable.cpp
+ * @brief Retrieve, grow and add operations of the ISAT cache.
+ */
+
+#include "ISATTable.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+ISATTable::ISATTable(Utility &model, CVODESSerialIntegrator &integrator, double tolerance, long maxBytes, int debug)
+    : model_(model), integrator_(integrator)
+{
+    NEQ_       = integrator_.getNEQ();
+    NX_        = NEQ_ + 1;
+    tol_       = tolerance;
+
+    nretrieve_ = 0;
+    ngrow_     = 0;
+    nadd_      = 0;
+    nevict_    = 0;
+    ndirect_   = 0;
+    debug_     = debug;
+
+    /* x0, f0, A, M plus the list node and vector headers */
+    long record_bytes = static_cast<long>(sizeof(double)) * (NX_ + NEQ_ + NEQ_ * NX_ + NX_ * NX_)
+                      + static_cast<long>(sizeof(Record)) + 2 * static_cast<long>(sizeof(void*));
+    max_records_ = maxBytes / record_bytes;
+
+    x_.resize(NX_);
+    dx_.resize(NX_);
+    Mdx_.resize(NX_);
+    f_.resize(NEQ_);
+    fp_.resize(NEQ_);
+    y_.resize(NEQ_);
+
+    if(debug_ == 1)
+    {
+        std::cout<<"--ISAT table: tolerance "<<tol_<<", "<<record_bytes<<" bytes per record, capacity "
+                 <<max_records_<<" records"<<std::endl;
+    }
+}
+
+
+void ISATTable::scaleQuery(double temperature, double pressure, const double *Y, double *x)
+{
+    x[0] = temperature / ChemConfig::ISAT_TEMPERATURE_SCALE;
+    for(int i = 1; i < NEQ_; i++)
+    {
+        x[i] = Y[i - 1];
+    }
+    x[NX_ - 1] = pressure / ChemConfig::ISAT_PRESSURE_SCALE;
+}
+
+
+void ISATTable::unscaleMapping(const double *f, double &temperature, double *Y)
+{
+    temperature = f[0] * ChemConfig::ISAT_TEMPERATURE_SCALE;
+    for(int i = 1; i < NEQ_; i++)
+    {
+        Y[i - 1] = f[i];
+    }
+}
+
+
+int ISATTable::integrateMapping(const double *x, double dt, double *f)
+{
+    int flag;
+
+    model_.setCellState(x[0] * ChemConfig::ISAT_TEMPERATURE_SCALE,
+                        x[NX_ - 1] * ChemConfig::ISAT_PRESSURE_SCALE, x + 1);
+    model_.setInitialState(y_.data());
+
+    integrator_.reset(0.0, y_.data());
+    flag = integrator_.advance(dt);
+    if(flag < 0)
+    {
+        return flag;
+    }
+
+    integrator_.getState(y_.data());
+    f[0] = y_[0] / ChemConfig::ISAT_TEMPERATURE_SCALE;
+    for(int i = 1; i < NEQ_; i++)
+    {
+        f[i] = y_[i];
+    }
+
+    return flag;
+}
+
+
+double ISATTable::ellipsoidDistance(const Record &r, const double *x)
+{
+    double s2 = 0.0;
+
+    for(int j = 0; j < NX_; j++)
+    {
+        dx_[j] = x[j] - r.x0[j];
+    }
+
+    for(int a = 0; a < NX_; a++)
+    {
+        const double *Ma  = &r.M[a * NX_];
+        double        sum = 0.0;
+        for(int b = 0; b < NX_; b++)
+        {
+            sum += Ma[b] * dx_[b];
+        }
+        Mdx_[a] = sum;
+        s2     += dx_[a] * sum;
+    }
+
+    return s2;
+}
+
+
+double ISATTable::extrapolationError(const Record &r, const double *f)
+{
+    double err = 0.0;
+
+    for(int i = 0; i < NEQ_; i++)
+    {
+        const double *Ai  = &r.A[i * NX_];
+        double        lin = r.f0[i];
+        for(int j = 0; j < NX_; j++)
+        {
+            lin += Ai[j] * dx_[j];
+        }
+        err += (f[i] - lin) * (f[i] - lin);
+    }
+
+    return std::sqrt(err);
+}
+
+
+void ISATTable::growEOA(Record &r, double s2)
+{
+    /* M' = M - (1 - 1/s2) (M dx)(M dx)^T / s2: x moves onto the boundary, the
+       directions M-orthogonal to dx keep their extent */
+    double c = (1.0 - 1.0 / s2) / s2;
+
+    for(int a = 0; a < NX_; a++)
+    {
+        double *Ma = &r.M[a * NX_];
+        for(int b = 0; b < NX_; b++)
+        {
+            Ma[b] -= c * Mdx_[a] * Mdx_[b];
+        }
+    }
+}
+
+
+bool ISATTable::addRecord(const double *x, const double *f, double dt)
+{
+    if(max_records_ < 1)
+    {
+        return false;
+    }
+
+    Record r;
+    r.dt = dt;
+    r.x0.assign(x, x + NX_);
+    r.f0.assign(f, f + NEQ_);
+    r.A.assign(NEQ_ * NX_, 0.0);
+    r.M.assign(NX_ * NX_, 0.0);
+
+    /* Mapping gradient: one forward difference per query component, each step
+       relative to its component so that trace radicals are not swamped; tol_
+       is the floor, below which retrieval cannot tell queries apart anyway */
+    std::vector<double> xp(x, x + NX_);
+
+    for(int j = 0; j < NX_; j++)
+    {
+        double delta = ChemConfig::ISAT_FD_DELTA * std::max(std::fabs(x[j]), tol_);
+        xp[j] = x[j] + delta;
+        int flag = integrateMapping(xp.data(), dt, fp_.data());
+        xp[j] = x[j];
+        if(flag < 0)
+        {
+            return false;
+        }
+
+        for(int i = 0; i < NEQ_; i++)
+        {
+            r.A[i * NX_ + j] = (fp_[i] - f[i]) / delta;
+        }
+    }
+
+    /* Initial EOA {dx : |A dx| <= tol}, with the singular values of A raised to at
+       least ISAT_EOA_MIN_SINGULAR so that it stays bounded: M = (A^T A + s^2 I) / tol^2 */
+    double smin2  = ChemConfig::ISAT_EOA_MIN_SINGULAR * ChemConfig::ISAT_EOA_MIN_SINGULAR;
+    double invtol = 1.0 / (tol_ * tol_);
+
+    for(int a = 0; a < NX_; a++)
+    {
+        for(int b = 0; b <= a; b++)
+        {
+            double sum = (a == b) ? smin2 : 0.0;
+            for(int i = 0; i < NEQ_; i++)
+            {
+                sum += r.A[i * NX_ + a] * r.A[i * NX_ + b];
+            }
+            r.M[a * NX_ + b] = sum * invtol;
+            r.M[b * NX_ + a] = sum * invtol;
+        }
+    }
+
+    if(static_cast<long>(records_.size()) >= max_records_)
+    {
+        records_.pop_back();                                                    /* Least recently used */
+        nevict_++;
+    }
+    records_.push_front(std::move(r));
+
+    return true;
+}
+
+
+int ISATTable::advance(double &temperature, double pressure, double *Y, double dt)
+{
+    scaleQuery(temperature, pressure, Y, x_.data());
+
+    /* Retrieve: scan the most recently used records, remember the nearest EOA */
+    auto   nearest  = records_.end();
+    double nearest2 = std::numeric_limits<double>::max();
+    int    nsearch  = 0;
+
+    for(auto it = records_.begin(); it != records_.end() && nsearch < ChemConfig::ISAT_MAX_SEARCH; ++it, ++nsearch)
+    {
+        if(std::fabs(it->dt - dt) > 1.0e-12 * dt)
+        {
+            continue;
+        }
+
+        double s2 = ellipsoidDistance(*it, x_.data());
+        if(s2 <= 1.0)
+        {
+            for(int i = 0; i < NEQ_; i++)
+            {
+                const double *Ai = &it->A[i * NX_];
+                double        fi = it->f0[i];
+                for(int j = 0; j < NX_; j++)
+                {
+                    fi += Ai[j] * dx_[j];
+                }
+                f_[i] = fi;
+            }
+
+            it->nused++;
+            records_.splice(records_.begin(), records_, it);
+            nretrieve_++;
+
+            unscaleMapping(f_.data(), temperature, Y);
+            return 0;
+        }
+
+        if(s2 < nearest2)
+        {
+            nearest2 = s2;
+            nearest  = it;
+        }
+    }
+
+    /* Miss: integrate, then grow the nearest record or add a new one */
+    int flag = integrateMapping(x_.data(), dt, f_.data());
+    if(flag < 0)
+    {
+        return flag;
+    }
+    ndirect_++;
+
+    if(nearest != records_.end())
+    {
+        ellipsoidDistance(*nearest, x_.data());                                 /* Restore dx_, Mdx_ for this record */
+        if(extrapolationError(*nearest, f_.data()) <= tol_)
+        {
+            growEOA(*nearest, nearest2);
+            records_.splice(records_.begin(), records_, nearest);
+            ngrow_++;
+
+            unscaleMapping(f_.data(), temperature, Y);
+            return flag;
+        }
+    }
+
+    if(addRecord(x_.data(), f_.data(), dt))
+    {
+        nadd_++;
+    }
+    else if(debug_ == 1)
+    {
+        std::cout<<"--ISAT table: record not added (gradient integration failed or zero capacity)"<<std::endl;
+    }
+
+    unscaleMapping(f_.data(), temperature, Y);
+    return flag;
+}
+
+
+void ISATTable::clear()
+{
+    records_.clear();
+}
+
+
+/* Debugger, getter fns */
+long ISATTable::getNumberofRecords()
+{
+    return static_cast<long>(records_.size());
+}
+
+
+long ISATTable::getMaxRecords()
+{
+    return max_records_;
+}
+
+
+long ISATTable::getNumberofRetrieves()
+{
+    return nretrieve_;
+}
+
+
+long ISATTable::getNumberofGrows()
+{
+    return ngrow_;
+}
+
+
+long ISATTable::getNumberofAdds()
+{
+    return nadd_;
+}
+
+
+long ISATTable::getNumberofEvictions()
+{
+    return nevict_;
+}
+
+
+long ISATTable::getNumberofDirectIntegrations()
+{
+    return ndirect_;
+}
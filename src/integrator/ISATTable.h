@@ -0,0 +1,179 @@
+/**
+ * @file ISATTable.h
+ * @brief In-situ adaptive tabulation (ISAT) of the reaction mapping over a CFD step
+ * @details
+ *  Caches the mapping x = (T, Y, P) -> f = (T', Y') over a step dt, computed by a
+ *  CVODESSerialIntegrator. Each record stores the query x0, the mapping f0, its
+ *  gradient A = df/dx and an ellipsoid of accuracy (EOA) {x : (x-x0)^T M (x-x0) <= 1}
+ *  inside which the linear extrapolation f0 + A (x - x0) is trusted.
+ *
+ *  A query is answered in one of three ways:
+ *      - Retrieve: some record's EOA contains x; no integration.
+ *      - Grow:     direct integration, and the nearest record's extrapolation
+ *                  turns out to be within tolerance; its EOA is enlarged to the
+ *                  smallest ellipsoid containing the old one and x.
+ *      - Add:      direct integration plus NEQ + 1 perturbed integrations for A;
+ *                  a new record is stored, evicting the least recently used one
+ *                  when the storage cap is reached.
+ *
+ *  Records live in a most-recently-used list; retrieval moves the hit to the
+ *  front and only the first ChemConfig::ISAT_MAX_SEARCH records are tested, so
+ *  states revisited step after step are found after a few tests.
+ *
+ *  All errors are measured in scaled variables: T / ISAT_TEMPERATURE_SCALE, Y as
+ *  is, P / ISAT_PRESSURE_SCALE. A is obtained by forward differences over warm
+ *  restarts of the integrator. Component j is perturbed by
+ *  ISAT_FD_DELTA * max(|x_j|, tolerance), so a radical at Y = 1e-6 moves by a
+ *  small fraction of itself, not by ISAT_FD_DELTA; the integrator's relative
+ *  tolerance should be well below ISAT_FD_DELTA and its absolute tolerance well
+ *  below ISAT_FD_DELTA * tolerance.
+ */
+
+#ifndef SRC_INTEGRATOR_ISAT_TABLE
+#define SRC_INTEGRATOR_ISAT_TABLE
+
+#include <vector>
+#include <list>
+
+#include "Utility.h"                                                            /*!< Model interface to provide setCellState(), setInitialState(). */
+#include "CVODESSerialIntegrator.h"                                             /*!< Direct integration of misses. */
+#include "ChemConfig.h"
+
+
+/**
+ * @class ISATTable
+ * @brief ISAT cache in front of a CVODESSerialIntegrator.
+ * @details
+ *  Usage:
+ *      1. Build the model and its integrator, call initializeandsetupsolver().
+ *      2. Construct the table on both.
+ *      3. advance(T, P, Y, dt) per cell and CFD step, instead of integrating.
+ */
+class ISATTable
+{
+    public:
+        /**
+         * @brief Empty table in front of an initialized integrator.
+         * @param[in] model Model integrated by @p integrator; must implement @ref Utility::setCellState().
+         * @param[in] integrator Integrator used for misses (non-owning).
+         * @param[in] tolerance Retrieval error bound in scaled variables.
+         * @param[in] maxBytes Record storage cap; LRU eviction beyond.
+         * @param[in] debug Debug flag (0 = quiet, 1 = verbose).
+         * @pre integrator.initializeandsetupsolver() has been called.
+         */
+        ISATTable (Utility &model, CVODESSerialIntegrator &integrator,
+                   double tolerance = ChemConfig::ISAT_TOLERANCE,
+                   long maxBytes = ChemConfig::ISAT_MAX_BYTES, int debug = 0);
+
+        /**
+         * @brief Advance one cell by @p dt through the table, in place.
+         * @param[in,out] temperature Temperature [K].
+         * @param[in] pressure Pressure [Pa], constant over the step.
+         * @param[in,out] Y Mass fractions (length NEQ - 1).
+         * @param[in] dt Time step [s]; records only match queries of the same dt.
+         * @return 0 if retrieved, else the CVode() flag of the direct integration
+         *         (negative on failure, cell left untouched).
+         */
+        int advance(double &temperature, double pressure, double *Y, double dt);
+
+        /**
+         * @brief Drop every record; statistics are kept.
+         */
+        void clear();
+
+        /* Debugger, getter fns */
+        long getNumberofRecords();
+        long getMaxRecords();                                                   /*!< Capacity implied by maxBytes.       */
+        long getNumberofRetrieves();
+        long getNumberofGrows();
+        long getNumberofAdds();
+        long getNumberofEvictions();
+        long getNumberofDirectIntegrations();                                   /*!< Excludes the gradient integrations. */
+
+
+    private:
+
+        /**
+         * @brief One tabulated mapping and its ellipsoid of accuracy (scaled variables).
+         */
+        struct Record
+        {
+            double              dt;                                             /*!< Step of the mapping [s].            */
+            std::vector<double> x0;                                             /*!< Query (length NX).                  */
+            std::vector<double> f0;                                             /*!< Mapping (length NEQ).               */
+            std::vector<double> A;                                              /*!< df/dx, row-major NEQ x NX.           */
+            std::vector<double> M;                                              /*!< EOA matrix, NX x NX symmetric.      */
+            long                nused = 0;                                      /*!< Retrieves served.                   */
+        };
+
+        Utility                &model_;                                         /*!< Model (non-owning).                 */
+        CVODESSerialIntegrator &integrator_;                                    /*!< Direct integrator (non-owning).     */
+
+        int    NEQ_;                                                            /*!< Mapping size, [T, Y1..Y_N].         */
+        int    NX_;                                                             /*!< Query size, NEQ + 1 (pressure).     */
+        double tol_;                                                            /*!< Retrieval error bound.              */
+        long   max_records_;                                                    /*!< Capacity.                           */
+
+        std::list<Record> records_;                                             /*!< Most recently used first.           */
+
+        /* Scratch */
+        std::vector<double> x_;                                                 /*!< Scaled query.                       */
+        std::vector<double> dx_;                                                /*!< x - x0.                             */
+        std::vector<double> Mdx_;                                               /*!< M (x - x0).                         */
+        std::vector<double> f_;                                                 /*!< Scaled mapping.                     */
+        std::vector<double> fp_;                                                /*!< Scaled mapping of a perturbed query. */
+        std::vector<double> y_;                                                 /*!< Unscaled model state.               */
+
+        /* Statistics */
+        long nretrieve_;
+        long ngrow_;
+        long nadd_;
+        long nevict_;
+        long ndirect_;
+
+        int debug_;
+
+        /**
+         * @brief Scale (T, Y, P) into @p x.
+         */
+        void scaleQuery(double temperature, double pressure, const double *Y, double *x);
+
+        /**
+         * @brief Integrate the scaled query @p x over @p dt into the scaled mapping @p f.
+         * @return CVode() flag.
+         */
+        int integrateMapping(const double *x, double dt, double *f);
+
+        /**
+         * @brief (x - x0)^T M (x - x0) for record @p r; <= 1 inside the EOA.
+         * @post dx_ and Mdx_ hold x - x0 and M (x - x0).
+         */
+        double ellipsoidDistance(const Record &r, const double *x);
+
+        /**
+         * @brief Scaled 2-norm error of the linear extrapolation of @p r at x against @p f.
+         * @pre dx_ holds x - x0 of @p r.
+         */
+        double extrapolationError(const Record &r, const double *f);
+
+        /**
+         * @brief Enlarge the EOA of @p r to the smallest ellipsoid containing it and x.
+         * @param[in] s2 (x - x0)^T M (x - x0) > 1.
+         * @pre dx_ and Mdx_ hold the values of the last ellipsoidDistance(r, x).
+         */
+        void growEOA(Record &r, double s2);
+
+        /**
+         * @brief Build a record at the scaled query @p x with mapping @p f.
+         * @return false if a perturbed integration failed; nothing is stored.
+         */
+        bool addRecord(const double *x, const double *f, double dt);
+
+        /**
+         * @brief Write a scaled mapping back to the caller's cell.
+         */
+        void unscaleMapping(const double *f, double &temperature, double *Y);
+};
+
+
+#endif /* SRC_INTEGRATOR_ISAT_TABLE */
@@ -0,0 +1,86 @@
+/**
+ * @file IntegratorEvent.h
+ * @brief Root-finding events for CVODESSerialIntegrator (ignition detection, peaks)
+ * @details
+ *  An event is a scalar function g(t, y, ydot, yddot) whose zero crossings CVODES
+ *  locates with CVodeRootInit(). Each crossing time is recorded; a terminal event
+ *  stops integrate()/advance() at the crossing.
+ */
+
+#ifndef SRC_INTEGRATOR_INTEGRATOR_EVENT
+#define SRC_INTEGRATOR_INTEGRATOR_EVENT
+
+#include <string>
+#include <vector>
+#include <functional>
+
+
+/**
+ * @brief Event function g(t, y, ydot, yddot); a root is a sign change of g.
+ * @note yddot = d(ydot)/dt is only filled for events with @ref IntegratorEvent::needsSecondDerivative.
+ */
+using EventFunction = std::function<double(double t, const double *y, const double *ydot, const double *yddot)>;
+
+
+/**
+ * @struct IntegratorEvent
+ * @brief One event: its function, crossing direction, stop policy and recorded times.
+ */
+struct IntegratorEvent
+{
+    std::string         name;                                                   /*!< Label used in messages.                          */
+    EventFunction       g;                                                      /*!< Event function.                                  */
+    int                 direction             = 0;                              /*!< +1 rising, -1 falling, 0 either (CVodeSetRootDirection). */
+    bool                terminal              = false;                          /*!< Stop integration at the first crossing.          */
+    bool                needsSecondDerivative = false;                          /*!< g reads yddot (one extra RHS call per evaluation). */
+    std::vector<double> times;                                                  /*!< Recorded crossing times [s].                     */
+
+
+    /**
+     * @brief y[index] crosses @p threshold, e.g. T crossing T0 + 400 K for ignition.
+     * @param[in] direction +1 rising (default), -1 falling, 0 either.
+     */
+    static IntegratorEvent stateCrossing(std::string name, int index, double threshold,
+                                         bool terminal = false, int direction = 1)
+    {
+        IntegratorEvent ev;
+        ev.name      = std::move(name);
+        ev.g         = [index, threshold](double, const double *y, const double *, const double *)
+                       { return y[index] - threshold; };
+        ev.direction = direction;
+        ev.terminal  = terminal;
+        return ev;
+    }
+
+    /**
+     * @brief Local maximum of y[index], e.g. a species mass-fraction peak (ydot[index] falls through 0).
+     */
+    static IntegratorEvent stateMaximum(std::string name, int index, bool terminal = false)
+    {
+        IntegratorEvent ev;
+        ev.name      = std::move(name);
+        ev.g         = [index](double, const double *, const double *ydot, const double *)
+                       { return ydot[index]; };
+        ev.direction = -1;
+        ev.terminal  = terminal;
+        return ev;
+    }
+
+    /**
+     * @brief Local maximum of ydot[index], e.g. max dT/dt as ignition marker (yddot[index] falls through 0).
+     */
+    static IntegratorEvent rateMaximum(std::string name, int index, bool terminal = false)
+    {
+        IntegratorEvent ev;
+        ev.name                  = std::move(name);
+        ev.g                     = [index](double, const double *, const double *, const double *yddot)
+                                   { return yddot[index]; };
+        ev.direction             = -1;
+        ev.terminal              = terminal;
+        ev.needsSecondDerivative = true;
+        return ev;
+    }
+};
+
+
+#endif /* SRC_INTEGRATOR_INTEGRATOR_EVENT */
@@ -0,0 +1,129 @@
+/**
+ * @file OutputSchedule.h
+ * @brief Output times for CVODESSerialIntegrator::integrate()
+ * @details
+ *  A schedule is one of:
+ *      - a sorted list of output times at which the integrator stops (CV_NORMAL);
+ *      - a streaming schedule: CV_ONE_STEP up to a final time, reporting after
+ *        every internal step;
+ *      - a sampled schedule: CV_ONE_STEP up to the last time, filling every
+ *        requested time inside each completed step by Nordsieck interpolation
+ *        (CVodeGetDky), so thousands of samples cost no extra steps.
+ */
+
+#ifndef SRC_INTEGRATOR_OUTPUT_SCHEDULE
+#define SRC_INTEGRATOR_OUTPUT_SCHEDULE
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+
+/**
+ * @brief Observer called with (t, y) at each output; y has length NEQ.
+ */
+using StepObserver = std::function<void(double t, const double *y)>;
+
+
+/**
+ * @class OutputSchedule
+ * @brief Linear, logarithmic, user-supplied or streaming output times.
+ */
+class OutputSchedule
+{
+    public:
+        /**
+         * @brief @p n equally spaced output times from @p tfirst to @p tlast (inclusive).
+         */
+        static OutputSchedule linear(double tfirst, double tlast, int n)
+        {
+            OutputSchedule s;
+            for(int i = 0; i < n; i++)
+            {
+                s.times_.push_back(n == 1 ? tlast : tfirst + (tlast - tfirst) * i / (n - 1));
+            }
+            return s;
+        }
+
+        /**
+         * @brief @p n logarithmically spaced output times from @p tfirst to @p tlast (inclusive).
+         * @pre 0 < tfirst <= tlast.
+         */
+        static OutputSchedule logarithmic(double tfirst, double tlast, int n)
+        {
+            OutputSchedule s;
+            double ratio = (n == 1) ? 1.0 : std::pow(tlast / tfirst, 1.0 / (n - 1));
+            double t     = tfirst;
+            for(int i = 0; i < n; i++)
+            {
+                s.times_.push_back(i == n - 1 ? tlast : t);                     /* Land exactly on tlast */
+                t *= ratio;
+            }
+            return s;
+        }
+
+        /**
+         * @brief User-supplied output times; sorted on construction.
+         */
+        static OutputSchedule list(std::vector<double> times)
+        {
+            OutputSchedule s;
+            s.times_ = std::move(times);
+            std::sort(s.times_.begin(), s.times_.end());
+            return s;
+        }
+
+        /**
+         * @brief Report after every internal step (CV_ONE_STEP) until @p tfinal.
+         */
+        static OutputSchedule streaming(double tfinal)
+        {
+            OutputSchedule s;
+            s.mode_ = Mode::Streaming;
+            s.times_.push_back(tfinal);
+            return s;
+        }
+
+        /**
+         * @brief Interpolate the state at @p times without stopping the integrator there.
+         * @param[in] times Sample times; sorted on construction.
+         */
+        static OutputSchedule sampled(std::vector<double> times)
+        {
+            OutputSchedule s = list(std::move(times));
+            s.mode_ = Mode::Sampled;
+            return s;
+        }
+
+        /**
+         * @brief @p n linearly spaced samples from @p tfirst to @p tlast, interpolated.
+         */
+        static OutputSchedule sampledLinear(double tfirst, double tlast, int n)
+        {
+            return sampled(linear(tfirst, tlast, n).times_);
+        }
+
+        /**
+         * @brief @p n logarithmically spaced samples from @p tfirst to @p tlast, interpolated.
+         */
+        static OutputSchedule sampledLogarithmic(double tfirst, double tlast, int n)
+        {
+            return sampled(logarithmic(tfirst, tlast, n).times_);
+        }
+
+        bool isStreaming() const                    { return mode_ == Mode::Streaming; }
+        bool isSampled() const                      { return mode_ == Mode::Sampled; }
+        const std::vector<double>& times() const    { return times_; }
+        double finalTime() const                    { return times_.empty() ? 0.0 : times_.back(); }
+
+
+    private:
+        enum class Mode { Stops, Streaming, Sampled };
+
+        std::vector<double> times_;                                             /*!< Output times (streaming: final time only). */
+        Mode                mode_ = Mode::Stops;                                /*!< How integrate() visits @ref times_.        */
+};
+
+
+#endif /* SRC_INTEGRATOR_OUTPUT_SCHEDULE */
@@ -0,0 +1,189 @@
+/**
+ * @file SUNDIALSHelpers.h
+ * @brief Small helpers shared by the CVODES integrator translation units.
+ * @details
+ *  check_retval(), and the dense BDF session that CVODESEnsembleIntegrator
+ *  (one per cell) and CVODESReactorPool (one per worker) both keep: Utility
+ *  RHS/Jacobian trampolines, setup and release.
+ */
+
+#ifndef SRC_INTEGRATOR_SUNDIALS_HELPERS
+#define SRC_INTEGRATOR_SUNDIALS_HELPERS
+
+#include <stdio.h>
+
+/** @name SUNDIALS includes
+ *  @{ */
+#include <cvodes/cvodes.h>          						                    /*!< Prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h> 						                    /*!< Access to serial N_Vector            */
+#include <sunlinsol/sunlinsol_dense.h> 						                    /*!< Access to dense SUNLinearSolver      */
+#include <sunmatrix/sunmatrix_dense.h> 						                    /*!< Access to dense SUNMatrix            */
+/** @} */
+
+#include "Utility.h"                                                            /*!< Model interface to provide setNEQ(), setInitialState(), evalRHS(), etc. */
+
+
+/**
+ * @brief Check a SUNDIALS return value and print an error message on failure.
+ * @param[in] returnvalue Pointer returned by the call (opt 0, 2) or pointer to its int flag (opt 1).
+ * @param[in] funcname Name of the SUNDIALS function, for the message.
+ * @param[in] opt 0 = NULL pointer check, 1 = flag < 0 check, 2 = memory NULL check.
+ * @return 0 on success, 1 on failure.
+ */
+inline int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  /* Check if retval < 0 */
+  else if (opt == 1)
+  {
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
+
+
+/**
+ * @brief CVODES RHS trampoline, user_data is a Utility model.
+ */
+inline int utility_cvode_rhs(double t, N_Vector y, N_Vector ydot, void* user_data)
+{
+    Utility *f = static_cast<Utility*>(user_data);
+
+    f->evalRHS(t, N_VGetArrayPointer(y), N_VGetArrayPointer(ydot));
+
+    return 0;
+}
+
+
+/**
+ * @brief CVODES dense Jacobian trampoline, user_data is a Utility model.
+ */
+inline int utility_cvode_jac(double t, N_Vector y, N_Vector fy, SUNMatrix J, void* user_data,
+                             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+    Utility *f = static_cast<Utility*>(user_data);
+
+    f->evalJacobian(t, N_VGetArrayPointer(y), N_VGetArrayPointer(fy), SUNDenseMatrix_Data(J));
+
+    return 0;
+}
+
+
+/**
+ * @brief One model's BDF session with a dense linear solver.
+ */
+struct DenseCVODESSession
+{
+    void           *cvode_mem = nullptr;                                        /*!< CVODES session handle.   */
+    N_Vector        y         = nullptr;                                        /*!< State.                   */
+    N_Vector        abstol    = nullptr;                                        /*!< Absolute tolerances.     */
+    SUNMatrix       A         = nullptr;                                        /*!< Dense NEQ×NEQ Jacobian.  */
+    SUNLinearSolver LS        = nullptr;                                        /*!< Dense linear solver.     */
+};
+
+
+/**
+ * @brief Create a dense BDF session for @p model, starting at @p t0 from its setInitialState().
+ * @param[out] s Session; on failure it holds whatever was built, for freeDenseSession().
+ * @param[in] model Model (non-owning); becomes the CVODES user data.
+ * @param[in] NEQ Number of equations.
+ * @param[in] t0 Initial time [s].
+ * @param[in] rtol Relative tolerance (scalar).
+ * @param[in] atol Absolute tolerance (all equations).
+ * @param[in] sunctx Context the objects are created on.
+ * @return 0 on success, 1 on failure.
+ */
+inline int setupDenseSession(DenseCVODESSession &s, Utility *model, int NEQ, double t0, double rtol, double atol,
+                             SUNContext sunctx)
+{
+    int flag;
+
+    s.y      = N_VNew_Serial(NEQ, sunctx);
+    s.abstol = N_VNew_Serial(NEQ, sunctx);
+    if(check_retval((void*)s.y, "N_VNew_Serial", 0) || check_retval((void*)s.abstol, "N_VNew_Serial", 0))
+    {
+        return (1);
+    }
+
+    model->setInitialState(N_VGetArrayPointer(s.y));
+    N_VConst(atol, s.abstol);
+
+    s.cvode_mem = CVodeCreate(CV_BDF, sunctx);
+    if(check_retval(s.cvode_mem, "CVodeCreate", 0))
+    {
+        return (1);
+    }
+
+    flag = CVodeInit(s.cvode_mem, utility_cvode_rhs, t0, s.y);
+    if(check_retval(&flag, "CVodeInit", 1)) return (1);
+
+    flag = CVodeSetUserData(s.cvode_mem, model);
+    if(check_retval(&flag, "CVodeSetUserData", 1)) return (1);
+
+    flag = CVodeSVtolerances(s.cvode_mem, rtol, s.abstol);
+    if(check_retval(&flag, "CVodeSVtolerances", 1)) return (1);
+
+    s.A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+    s.LS = SUNLinSol_Dense(s.y, s.A, sunctx);
+    if(check_retval((void*)s.A, "SUNDenseMatrix", 0) || check_retval((void*)s.LS, "SUNLinSol_Dense", 0))
+    {
+        return (1);
+    }
+
+    flag = CVodeSetLinearSolver(s.cvode_mem, s.LS, s.A);
+    if(check_retval(&flag, "CVodeSetLinearSolver", 1)) return (1);
+
+    if(model->hasJacobian())
+    {
+        flag = CVodeSetJacFn(s.cvode_mem, utility_cvode_jac);
+        if(check_retval(&flag, "CVodeSetJacFn", 1)) return (1);
+    }
+
+    return (0);
+}
+
+
+/**
+ * @brief Release a session built (fully or partly) by setupDenseSession().
+ * @note Idempotent: the handles are nulled.
+ */
+inline void freeDenseSession(DenseCVODESSession &s)
+{
+    N_VDestroy(s.y);
+    N_VDestroy(s.abstol);
+    CVodeFree(&s.cvode_mem);
+    SUNLinSolFree(s.LS);
+    SUNMatDestroy(s.A);
+
+    s.y      = nullptr;
+    s.abstol = nullptr;
+    s.LS     = nullptr;
+    s.A      = nullptr;
+}
+
+
+#endif /* SRC_INTEGRATOR_SUNDIALS_HELPERS */
@@ -0,0 +1,421 @@
+#include "SUNLinSolSmallDense.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+
+/* ------------------------------------------------------------------------------------------------
+ * Kernels: column-major n×n, N > 0 fixes n at compile time, N = 0 reads it at run time
+ * ------------------------------------------------------------------------------------------------ */
+
+/**
+ * @brief In-place LU with partial pivoting, LAPACK getrf layout (unit L below, U on and above).
+ * @tparam Real double, or float for the mixed-precision factors.
+ * @return 0, or k+1 if column k has no nonzero pivot.
+ */
+template<typename Real, int N>
+static int factorLU(int n_runtime, Real *a, int *piv)
+{
+    const int n = (N > 0) ? N : n_runtime;
+
+    for(int k = 0; k < n; k++)
+    {
+        Real *ak = &a[k * n];
+
+        int  p    = k;
+        Real amax = std::fabs(ak[k]);
+        for(int i = k + 1; i < n; i++)
+        {
+            if(std::fabs(ak[i]) > amax)
+            {
+                amax = std::fabs(ak[i]);
+                p    = i;
+            }
+        }
+        piv[k] = p;
+        if(amax == Real(0))
+        {
+            return k + 1;
+        }
+
+        if(p != k)
+        {
+            for(int j = 0; j < n; j++)
+            {
+                std::swap(a[j * n + k], a[j * n + p]);                          /* Whole row, L part included */
+            }
+        }
+
+        Real inv = Real(1) / ak[k];
+        for(int i = k + 1; i < n; i++)
+        {
+            ak[i] *= inv;
+        }
+
+        /* Trailing update, four columns per pass so each multiplier column ak[i] is
+         * loaded once for four fused multiply-adds */
+        int j = k + 1;
+        for(; j + 3 < n; j += 4)
+        {
+            Real *a0 = &a[j * n];
+            Real *a1 = a0 + n;
+            Real *a2 = a1 + n;
+            Real *a3 = a2 + n;
+            Real  m0 = a0[k], m1 = a1[k], m2 = a2[k], m3 = a3[k];
+            for(int i = k + 1; i < n; i++)
+            {
+                Real l = ak[i];
+                a0[i] -= m0 * l;
+                a1[i] -= m1 * l;
+                a2[i] -= m2 * l;
+                a3[i] -= m3 * l;
+            }
+        }
+        for(; j < n; j++)
+        {
+            Real *aj = &a[j * n];
+            Real  m  = aj[k];
+            for(int i = k + 1; i < n; i++)
+            {
+                aj[i] -= m * ak[i];
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Solve A x = b in place on @p x with the factors of factorLU().
+ */
+template<typename Real, int N>
+static void solveLU(int n_runtime, const Real *a, const int *piv, Real *x)
+{
+    const int n = (N > 0) ? N : n_runtime;
+
+    for(int k = 0; k < n; k++)
+    {
+        if(piv[k] != k)
+        {
+            std::swap(x[k], x[piv[k]]);
+        }
+    }
+
+    /* L y = P b, column-oriented */
+    for(int k = 0; k < n; k++)
+    {
+        const Real *ak = &a[k * n];
+        Real        xk = x[k];
+        for(int i = k + 1; i < n; i++)
+        {
+            x[i] -= xk * ak[i];
+        }
+    }
+
+    /* U x = y, column-oriented */
+    for(int k = n - 1; k >= 0; k--)
+    {
+        const Real *ak = &a[k * n];
+        x[k] /= ak[k];
+        Real xk = x[k];
+        for(int i = 0; i < k; i++)
+        {
+            x[i] -= xk * ak[i];
+        }
+    }
+}
+
+
+template<typename Real>
+using FactorFn = int  (*)(int, Real*, int*);
+template<typename Real>
+using SolveFn  = void (*)(int, const Real*, const int*, Real*);
+
+constexpr int MAX_N = ChemConfig::SMALL_LU_MAX_NEQ;
+
+/* Entry n holds the kernels for size n; entry 0 the run-time size ones */
+template<typename Real, int... Ns>
+static constexpr std::array<FactorFn<Real>, MAX_N + 1> makeFactorTable(std::integer_sequence<int, Ns...>)
+{
+    return {factorLU<Real, 0>, factorLU<Real, Ns + 1>...};
+}
+
+template<typename Real, int... Ns>
+static constexpr std::array<SolveFn<Real>, MAX_N + 1> makeSolveTable(std::integer_sequence<int, Ns...>)
+{
+    return {solveLU<Real, 0>, solveLU<Real, Ns + 1>...};
+}
+
+template<typename Real>
+static FactorFn<Real> factorKernel(int n)
+{
+    static constexpr std::array<FactorFn<Real>, MAX_N + 1> table = makeFactorTable<Real>(std::make_integer_sequence<int, MAX_N>{});
+    return table[(n <= MAX_N) ? n : 0];
+}
+
+template<typename Real>
+static SolveFn<Real> solveKernel(int n)
+{
+    static constexpr std::array<SolveFn<Real>, MAX_N + 1> table = makeSolveTable<Real>(std::make_integer_sequence<int, MAX_N>{});
+    return table[(n <= MAX_N) ? n : 0];
+}
+
+
+/* ------------------------------------------------------------------------------------------------
+ * SUNLinearSolver
+ * ------------------------------------------------------------------------------------------------ */
+
+/**
+ * @brief Solver content: factors, pivots and the size-specialized kernels.
+ */
+struct SmallDenseContent
+{
+    int                 n;                                                      /*!< System size.                          */
+    bool                mixed;                                                  /*!< Factors in float, refined in double.  */
+    sunindextype        last_flag;                                              /*!< 0, or k+1 for a zero pivot.           */
+    long                refinements;                                            /*!< Refinement sweeps so far (mixed).     */
+    FactorFn<double>    factor;                                                 /*!< factorLU<double, n>.                  */
+    SolveFn<double>     solve;                                                  /*!< solveLU<double, n>.                   */
+    FactorFn<float>     factor_f;                                               /*!< factorLU<float, n>.                   */
+    SolveFn<float>      solve_f;                                                /*!< solveLU<float, n>.                    */
+    std::vector<int>    piv;                                                    /*!< Row interchanges.                     */
+    std::vector<double> lu;                                                     /*!< Double LU factors, column-major.      */
+    std::vector<float>  lu_f;                                                   /*!< Float LU factors, column-major.       */
+    std::vector<float>  x_f;                                                    /*!< Float right-hand side / correction.   */
+    std::vector<double> b;                                                      /*!< Copy of b for the residual.           */
+    std::vector<double> r;                                                      /*!< Residual b - A x.                     */
+};
+
+
+static SmallDenseContent* content(SUNLinearSolver S)
+{
+    return static_cast<SmallDenseContent*>(S->content);
+}
+
+
+static SUNLinearSolver_Type smalldense_gettype(SUNLinearSolver S)
+{
+    return SUNLINEARSOLVER_DIRECT;
+}
+
+
+static SUNLinearSolver_ID smalldense_getid(SUNLinearSolver S)
+{
+    return SUNLINEARSOLVER_CUSTOM;
+}
+
+
+static SUNErrCode smalldense_initialize(SUNLinearSolver S)
+{
+    content(S)->last_flag = 0;
+    return SUN_SUCCESS;
+}
+
+
+static int smalldense_setup(SUNLinearSolver S, SUNMatrix A)
+{
+    SmallDenseContent *c  = content(S);
+    const double      *a  = SUNDenseMatrix_Data(A);                             /* ldim = n */
+    int                nn = c->n * c->n;
+
+    if(c->mixed)
+    {
+        for(int k = 0; k < nn; k++)
+        {
+            c->lu_f[k] = static_cast<float>(a[k]);
+        }
+        c->last_flag = c->factor_f(c->n, c->lu_f.data(), c->piv.data());
+    }
+    else
+    {
+        for(int k = 0; k < nn; k++)
+        {
+            c->lu[k] = a[k];
+        }
+        c->last_flag = c->factor(c->n, c->lu.data(), c->piv.data());
+    }
+
+    return (c->last_flag > 0) ? SUNLS_LUFACT_FAIL : SUN_SUCCESS;               /* Recoverable: CVODES cuts the step */
+}
+
+
+/**
+ * @brief x = A^{-1} b from the float factors, refined against the double matrix @p A.
+ * @details
+ *   Each sweep forms r = b - A x in double and adds the float solve of r to x,
+ *   until ||r||_inf <= ChemConfig::MIXED_LU_REFINE_RTOL * ||b||_inf or
+ *   ChemConfig::MIXED_LU_MAX_REFINE sweeps. A is the matrix of the last setup.
+ */
+static void smalldense_solve_mixed(SmallDenseContent *c, const double *a, double *x)
+{
+    int    n     = c->n;
+    double bnorm = 0.0;
+
+    for(int i = 0; i < n; i++)
+    {
+        c->x_f[i] = static_cast<float>(c->b[i]);
+        bnorm     = std::max(bnorm, std::fabs(c->b[i]));
+    }
+    c->solve_f(n, c->lu_f.data(), c->piv.data(), c->x_f.data());
+    for(int i = 0; i < n; i++)
+    {
+        x[i] = c->x_f[i];
+    }
+
+    for(int sweep = 0; sweep < ChemConfig::MIXED_LU_MAX_REFINE; sweep++)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            c->r[i] = c->b[i];
+        }
+        for(int j = 0; j < n; j++)
+        {
+            const double *aj = &a[j * n];
+            double        xj = x[j];
+            for(int i = 0; i < n; i++)
+            {
+                c->r[i] -= aj[i] * xj;
+            }
+        }
+
+        double rnorm = 0.0;
+        for(int i = 0; i < n; i++)
+        {
+            rnorm = std::max(rnorm, std::fabs(c->r[i]));
+        }
+        if(rnorm <= ChemConfig::MIXED_LU_REFINE_RTOL * bnorm)
+        {
+            return;
+        }
+
+        for(int i = 0; i < n; i++)
+        {
+            c->x_f[i] = static_cast<float>(c->r[i]);
+        }
+        c->solve_f(n, c->lu_f.data(), c->piv.data(), c->x_f.data());
+        for(int i = 0; i < n; i++)
+        {
+            x[i] += c->x_f[i];
+        }
+        c->refinements++;
+    }
+}
+
+
+static int smalldense_solve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b, sunrealtype tol)
+{
+    SmallDenseContent *c  = content(S);
+    double            *xd = N_VGetArrayPointer(x);
+    const double      *bd = N_VGetArrayPointer(b);
+
+    if(c->mixed)
+    {
+        c->b.assign(bd, bd + c->n);                                             /* x and b may alias */
+        smalldense_solve_mixed(c, SUNDenseMatrix_Data(A), xd);
+        c->last_flag = 0;
+        return SUN_SUCCESS;
+    }
+
+    if(xd != bd)
+    {
+        for(int i = 0; i < c->n; i++)
+        {
+            xd[i] = bd[i];
+        }
+    }
+
+    c->solve(c->n, c->lu.data(), c->piv.data(), xd);                            /* Factors of the last setup */
+    c->last_flag = 0;
+    return SUN_SUCCESS;
+}
+
+
+static sunindextype smalldense_lastflag(SUNLinearSolver S)
+{
+    return content(S)->last_flag;
+}
+
+
+static SUNErrCode smalldense_space(SUNLinearSolver S, long *lenrwLS, long *leniwLS)
+{
+    SmallDenseContent *c = content(S);
+
+    *lenrwLS = c->mixed ? (c->n * c->n + 1) / 2 + 3 * c->n : c->n * c->n;       /* float counted as half a real */
+    *leniwLS = c->n + 3;
+    return SUN_SUCCESS;
+}
+
+
+static SUNErrCode smalldense_free(SUNLinearSolver S)
+{
+    if(S == nullptr)
+    {
+        return SUN_SUCCESS;
+    }
+
+    delete content(S);
+    S->content = nullptr;
+    SUNLinSolFreeEmpty(S);
+    return SUN_SUCCESS;
+}
+
+
+SUNLinearSolver SUNLinSol_SmallDense(N_Vector y, SUNMatrix A, SUNContext sunctx, bool mixedPrecision)
+{
+    sunindextype n = SUNDenseMatrix_Rows(A);
+
+    if(SUNMatGetID(A) != SUNMATRIX_DENSE || SUNDenseMatrix_Columns(A) != n)
+    {
+        return nullptr;
+    }
+
+    SUNLinearSolver S = SUNLinSolNewEmpty(sunctx);
+    if(S == nullptr)
+    {
+        return nullptr;
+    }
+
+    S->ops->gettype    = smalldense_gettype;
+    S->ops->getid      = smalldense_getid;
+    S->ops->initialize = smalldense_initialize;
+    S->ops->setup      = smalldense_setup;
+    S->ops->solve      = smalldense_solve;
+    S->ops->lastflag   = smalldense_lastflag;
+    S->ops->space      = smalldense_space;
+    S->ops->free       = smalldense_free;
+
+    SmallDenseContent *c = new SmallDenseContent;
+    c->n           = static_cast<int>(n);
+    c->mixed       = mixedPrecision;
+    c->last_flag   = 0;
+    c->refinements = 0;
+    c->factor      = factorKernel<double>(c->n);
+    c->solve       = solveKernel<double>(c->n);
+    c->factor_f    = factorKernel<float>(c->n);
+    c->solve_f     = solveKernel<float>(c->n);
+    c->piv.assign(n, 0);
+    if(mixedPrecision)
+    {
+        c->lu_f.assign(n * n, 0.0f);
+        c->x_f.assign(n, 0.0f);
+        c->b.assign(n, 0.0);
+        c->r.assign(n, 0.0);
+    }
+    else
+    {
+        c->lu.assign(n * n, 0.0);
+    }
+    S->content = c;
+
+    return S;
+}
+
+
+long SUNLinSol_SmallDenseNumRefinements(SUNLinearSolver S)
+{
+    return content(S)->refinements;
+}
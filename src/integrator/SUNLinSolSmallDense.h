@@ -0,0 +1,51 @@
+/**
+ * @file SUNLinSolSmallDense.h
+ * @brief Dense LU SUNLinearSolver with compile-time size kernels for small systems.
+ * @details
+ *  SUNLinSol_Dense is written for any size and keeps its loop bounds, strides
+ *  and pivot bookkeeping at run time. For the 10-60 species mechanisms the
+ *  Newton matrix fits in L1 and the solve is dominated by loop overhead, so
+ *  this solver dispatches, once at creation, to a partial-pivoting LU whose
+ *  size is a template parameter: every loop has a compile-time trip count and
+ *  the column updates of the factorization and the triangular solves are
+ *  contiguous, unit-stride and vectorized.
+ *
+ *  It works on the SUNDenseMatrix CVODES already builds (column-major, I -
+ *  gamma*J). setup() factors a private copy; solve() reuses those factors for
+ *  every Newton iteration until CVODES requests the next setup. Larger systems
+ *  use the same kernels with a run-time size.
+ *
+ *  Mixed precision: the factors are stored and computed in float (half the
+ *  memory, twice the SIMD lanes) while b, x and the matrix stay in double.
+ *  solve() checks r = b - A x in double and refines x with float solves of r
+ *  until ||r|| is small, which recovers double-level solves for well-conditioned
+ *  Newton matrices; the Newton iteration only needs an approximate one anyway.
+ */
+
+#ifndef SRC_INTEGRATOR_SUNLINSOL_SMALL_DENSE
+#define SRC_INTEGRATOR_SUNLINSOL_SMALL_DENSE
+
+#include <nvector/nvector_serial.h>
+#include <sunmatrix/sunmatrix_dense.h>
+
+#include "ChemConfig.h"                                                         /* SMALL_LU_MAX_NEQ, MIXED_LU_* */
+
+
+/**
+ * @brief Create the small dense LU solver for @p A.
+ * @param[in] y Template vector (serial, length N).
+ * @param[in] A Square SUNDenseMatrix; sizes up to ChemConfig::SMALL_LU_MAX_NEQ get compile-time kernels.
+ * @param[in] sunctx SUNDIALS context.
+ * @param[in] mixedPrecision Factor in float and refine in double (see file details). (default: false)
+ * @return The solver, or NULL if @p A is not a square dense matrix.
+ * @note Freed with SUNLinSolFree(), like the stock solvers.
+ */
+SUNLinearSolver SUNLinSol_SmallDense(N_Vector y, SUNMatrix A, SUNContext sunctx, bool mixedPrecision = false);
+
+/**
+ * @brief Iterative-refinement sweeps taken so far by a mixed-precision solver.
+ */
+long SUNLinSol_SmallDenseNumRefinements(SUNLinearSolver S);
+
+
+#endif /* SRC_INTEGRATOR_SUNLINSOL_SMALL_DENSE */
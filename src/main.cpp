@@ -2,13 +2,140 @@
 #include "IdealGasConstPressureAdiabaticReactor.h"
 #include "Utility.h"
 #include "IdealGasConstPressureAdiabaticReactorAdapter.h"
+#include "Reactor.h"
+#include "ADJacobianAdapter.h"
 #include "ChemConfig.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+
+
+/**
+ * @brief Time a sweep of warm-restarted cells with one linear solver.
+ * @param[in] type Linear solver under test.
+ * @param[in] name Label for the printout.
+ * @details Same cells, method and tolerances for every solver, so the wall time, setup
+ *          count and mean final temperature compare the linear solvers alone.
+ */
+static void benchmarkLinearSolver(LinearSolverType type, const char* name)
+{
+    const int    ncells = 64;
+    const double dt     = 1.0e-4;                                               /* Seconds per cell */
+
+    IdealGasConstPressureAdiabaticReactor        reactor(10, 1500.0);
+    IdealGasConstPressureAdiabaticReactorAdapter adapter(reactor);
+    CVODESSerialIntegrator integ(adapter);
+    integ.setLinearSolverType(type);
+    integ.setIntegrationMethod(IntegrationMethod::BDF);
+    integ.initializeandsetupsolver();
+
+    int nspecies = static_cast<int>(reactor.getNumberofSpecies());
+    std::vector<double> Y(nspecies, 1.0 / nspecies);
+    std::vector<double> y(integ.getNEQ());
+
+    double Tsum   = 0.0;
+    long   setups = 0;
+    auto   start  = std::chrono::steady_clock::now();
+    for(int c = 0; c < ncells; c++)
+    {
+        reactor.setCellState(1200.0 + 10.0 * c, ChemConfig::p0, Y.data());
+        reactor.setInitialState(y.data());
+        integ.reset(0.0, y.data());
+        integ.advance(dt);
+        integ.getState(y.data());
+
+        Tsum   += y[0];
+        setups += integ.getNumberofLinearSetups();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout<<"--"<<name<<": "<<ms<<" ms, "<<setups<<" setups, "<<integ.getNumberofRefinements()
+             <<" refinements, mean T = "<<Tsum / ncells<<" K"<<std::endl;
+    integ.freeMemory();
+}
 
 
-int main()
+/**
+ * @brief Compare the AD Jacobian of Reactor<N> with difference quotients of its RHS.
+ * @details Uniform composition at 1500 K, where every reaction is active. Prints the
+ *          largest entry difference relative to the largest entry of the Jacobian;
+ *          expect the difference-quotient error, about 1e-6.
+ */
+static void checkADJacobian()
 {
+    using FixedReactor = Reactor<CHEMGEN_NSPECIES>;
+
+    FixedReactor                    reactor(1500.0, ChemConfig::p0);
+    ADJacobianAdapter<FixedReactor> adapter(reactor);
+
+    const int NEQ = adapter.setNEQ();
+    std::vector<double> y(NEQ), yp(NEQ), f(NEQ), fp(NEQ), J(NEQ * NEQ);
+    adapter.setInitialState(y.data());
+    adapter.evalRHS(0.0, y.data(), f.data());
+    adapter.evalJacobian(0.0, y.data(), f.data(), J.data());
+
+    double maxdiff = 0.0;
+    double maxJ    = 0.0;
+    for(int j = 0; j < NEQ; j++)
+    {
+        double h = 1.0e-7 * std::max(std::fabs(y[j]), 1.0e-8);
+        yp       = y;
+        yp[j]   += h;
+        adapter.evalRHS(0.0, yp.data(), fp.data());
+        for(int i = 0; i < NEQ; i++)
+        {
+            maxdiff = std::max(maxdiff, std::fabs(J[j * NEQ + i] - (fp[i] - f[i]) / h));
+            maxJ    = std::max(maxJ, std::fabs(J[j * NEQ + i]));
+        }
+    }
+
+    std::cout<<"--AD Jacobian check: max |J_AD - J_DQ| / max |J| = "<<maxdiff / maxJ<<std::endl;
+}
+
+
+/**
+ * @brief Run the reactor test case.
+ * @details Options:
+ *   - --benchmark-linsol: also time the dense linear solvers (see
+ *     benchmarkLinearSolver()) before the main run.
+ *   - --thermo-table=linear|cubic: tabulate cp and h (ThermoMode) instead of
+ *     evaluating them exactly.
+ *   - --ad-jacobian: integrate Reactor<N> with its forward-mode AD Jacobian
+ *     (ADJacobianAdapter) instead, after checking it against difference quotients.
+ */
+int main(int argc, char *argv[])
+{
+    bool       benchmark  = false;
+    bool       adJacobian = false;
+    ThermoMode thermoMode = ThermoMode::Exact;
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--benchmark-linsol")
+        {
+            benchmark = true;
+        }
+        else if(arg == "--thermo-table=linear")
+        {
+            thermoMode = ThermoMode::TableLinear;
+        }
+        else if(arg == "--thermo-table=cubic")
+        {
+            thermoMode = ThermoMode::TableCubic;
+        }
+        else if(arg == "--ad-jacobian")
+        {
+            adJacobian = true;
+        }
+        else
+        {
+            std::cout<<"--Unknown option "<<arg<<" ignored"<<std::endl;
+        }
+    }
 
 /*------------------------------Chemgen routine------------------------------*/
 
@@ -33,11 +160,42 @@ int main()
 /*---------------------------------------------------------------------------*/
 
 
+/*------------------------------Linear solver benchmark----------------------*/
+
+    /* Opt-in; runs first: every integrator rewrites the stats CSV */
+    if(benchmark)
+    {
+        benchmarkLinearSolver(LinearSolverType::Dense,      "Dense (double SUNDenseMatrix LU)");
+        benchmarkLinearSolver(LinearSolverType::SmallDense, "SmallDense (size-specialized LU)");
+        benchmarkLinearSolver(LinearSolverType::MixedDense, "MixedDense (float LU + refinement)");
+    }
+
+/*---------------------------------------------------------------------------*/
+
+
+/*------------------------------AD Jacobian (Reactor<N>)---------------------*/
+
+    if(adJacobian)
+    {
+        checkADJacobian();
+
+        Reactor<CHEMGEN_NSPECIES>                    fixed(300.9470);
+        ADJacobianAdapter<Reactor<CHEMGEN_NSPECIES>> adAdapter(fixed);
+        CVODESSerialIntegrator integ(adAdapter);
+        std::cout<<"--Number of Eqns: "<<integ.getNEQ()<<std::endl;
+        integ.setLinearSolverType(LinearSolverType::Dense);                     /* AD Jacobian is dense */
+        integ.initializeandsetupsolver();
+        integ.integrate();
+        return 0;
+    }
+
 /*---------------------------------------------------------------------------*/
 
     IdealGasConstPressureAdiabaticReactorAdapter adapter(reactor);
+    adapter.setThermoMode(thermoMode);
     CVODESSerialIntegrator integ(adapter);
     std::cout<<"--Number of Eqns: "<<integ.getNEQ()<<std::endl;
+    integ.setLinearSolverType(LinearSolverType::Automatic);                     /* Sparse (KLU) for large mechanisms */
     integ.initializeandsetupsolver();
     integ.integrate();
 